@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Open addressing hash map with linear probing for integral keys (e.g. ids).
+ * Entries are stored contiguously, erasing uses backward shifting (no tombstones).
+ */
+template<typename Key, typename Value>
+class FlatHashMap
+{
+public:
+	using value_type = std::pair<Key, Value>;
+
+	template<typename MapType, typename EntryType>
+	class Iterator
+	{
+	public:
+		Iterator(MapType* map, size_t index) : _map(map), _index(index) { skipEmptySlots(); }
+
+		EntryType& operator*() const { return _map->_entries[_index]; }
+		EntryType* operator->() const { return &_map->_entries[_index]; }
+		Iterator& operator++() { ++_index; skipEmptySlots(); return *this; }
+		bool operator==(Iterator const& other) const { return _index == other._index; }
+		bool operator!=(Iterator const& other) const { return _index != other._index; }
+
+	private:
+		void skipEmptySlots()
+		{
+			while (_index < _map->_entries.size() && !_map->_occupied[_index]) {
+				++_index;
+			}
+		}
+
+		MapType* _map;
+		size_t _index;
+	};
+	using iterator = Iterator<FlatHashMap, value_type>;
+	using const_iterator = Iterator<FlatHashMap const, value_type const>;
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, _entries.size()); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, _entries.size()); }
+
+	size_t size() const { return _size; }
+	bool empty() const { return 0 == _size; }
+
+	void clear()
+	{
+		std::fill(_occupied.begin(), _occupied.end(), 0);
+		_size = 0;
+	}
+
+	void reserve(size_t numEntries)
+	{
+		if (numEntries * 10 > _entries.size() * 7) {
+			rehash(numEntries);
+		}
+	}
+
+	iterator find(Key const& key)
+	{
+		return iterator(this, findSlot(key));
+	}
+
+	const_iterator find(Key const& key) const
+	{
+		return const_iterator(this, findSlot(key));
+	}
+
+	size_t count(Key const& key) const
+	{
+		return findSlot(key) != _entries.size() ? 1 : 0;
+	}
+
+	Value& at(Key const& key)
+	{
+		auto const slot = findSlot(key);
+		if (slot == _entries.size()) {
+			throw std::out_of_range("FlatHashMap::at");
+		}
+		return _entries[slot].second;
+	}
+
+	Value const& at(Key const& key) const
+	{
+		auto const slot = findSlot(key);
+		if (slot == _entries.size()) {
+			throw std::out_of_range("FlatHashMap::at");
+		}
+		return _entries[slot].second;
+	}
+
+	void insert_or_assign(Key const& key, Value const& value)
+	{
+		reserve(_size + 1);
+		auto slot = getHomeSlot(key);
+		while (_occupied[slot]) {
+			if (_entries[slot].first == key) {
+				_entries[slot].second = value;
+				return;
+			}
+			slot = (slot + 1) & getMask();
+		}
+		_entries[slot] = value_type(key, value);
+		_occupied[slot] = 1;
+		++_size;
+	}
+
+	size_t erase(Key const& key)
+	{
+		auto slot = findSlot(key);
+		if (slot == _entries.size()) {
+			return 0;
+		}
+
+		//shift subsequent entries of the probe sequence backward to close the gap
+		auto const mask = getMask();
+		auto next = slot;
+		while (true) {
+			next = (next + 1) & mask;
+			if (!_occupied[next]) {
+				break;
+			}
+			auto const home = getHomeSlot(_entries[next].first);
+			bool const movable = next > slot ? (home <= slot || home > next) : (home <= slot && home > next);
+			if (movable) {
+				_entries[slot] = std::move(_entries[next]);
+				slot = next;
+			}
+		}
+		_occupied[slot] = 0;
+		--_size;
+		return 1;
+	}
+
+private:
+	static uint64_t hash(Key const& key)
+	{
+		auto result = static_cast<uint64_t>(key);
+		result ^= result >> 33;
+		result *= 0xff51afd7ed558ccdULL;
+		result ^= result >> 33;
+		return result;
+	}
+
+	size_t getMask() const { return _entries.size() - 1; }
+	size_t getHomeSlot(Key const& key) const { return static_cast<size_t>(hash(key)) & getMask(); }
+
+	size_t findSlot(Key const& key) const
+	{
+		if (0 == _size) {
+			return _entries.size();
+		}
+		auto slot = getHomeSlot(key);
+		while (_occupied[slot]) {
+			if (_entries[slot].first == key) {
+				return slot;
+			}
+			slot = (slot + 1) & getMask();
+		}
+		return _entries.size();
+	}
+
+	void rehash(size_t numEntries)
+	{
+		size_t capacity = 16;
+		while (numEntries * 10 > capacity * 7) {
+			capacity *= 2;
+		}
+
+		std::vector<value_type> oldEntries(capacity);
+		std::vector<uint8_t> oldOccupied(capacity, 0);
+		oldEntries.swap(_entries);
+		oldOccupied.swap(_occupied);
+		_size = 0;
+		for (size_t i = 0; i < oldEntries.size(); ++i) {
+			if (oldOccupied[i]) {
+				insert_or_assign(oldEntries[i].first, oldEntries[i].second);
+			}
+		}
+	}
+
+	std::vector<value_type> _entries;
+	std::vector<uint8_t> _occupied;
+	size_t _size = 0;
+};
+
+template<typename Key>
+class FlatHashSet
+{
+public:
+	class const_iterator
+	{
+	public:
+		const_iterator(typename FlatHashMap<Key, bool>::const_iterator const& mapIterator) : _mapIterator(mapIterator) {}
+
+		Key const& operator*() const { return _mapIterator->first; }
+		const_iterator& operator++() { ++_mapIterator; return *this; }
+		bool operator==(const_iterator const& other) const { return _mapIterator == other._mapIterator; }
+		bool operator!=(const_iterator const& other) const { return _mapIterator != other._mapIterator; }
+
+	private:
+		typename FlatHashMap<Key, bool>::const_iterator _mapIterator;
+	};
+	using iterator = const_iterator;
+
+	const_iterator begin() const { return _map.begin(); }
+	const_iterator end() const { return _map.end(); }
+	const_iterator find(Key const& key) const { return _map.find(key); }
+
+	size_t size() const { return _map.size(); }
+	bool empty() const { return _map.empty(); }
+	size_t count(Key const& key) const { return _map.count(key); }
+
+	void clear() { _map.clear(); }
+	void reserve(size_t numEntries) { _map.reserve(numEntries); }
+	void insert(Key const& key) { _map.insert_or_assign(key, true); }
+	size_t erase(Key const& key) { return _map.erase(key); }
+
+private:
+	FlatHashMap<Key, bool> _map;
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#ifdef __CUDACC__
+#define LOCK_FREE_HASH_FUNCTION __inline__ __host__ __device__
+#else
+#include <atomic>
+#define LOCK_FREE_HASH_FUNCTION inline
+#endif
+
+/**
+ * Lock-free open addressing hash map with linear probing for host (std::atomic) and device (atomicCAS).
+ * Each entry has a state word consisting of a generation and a busy/ready flag. Entries of other generations are free,
+ * hence reset only increments the generation and there are no tombstones. Memory is provided by the caller.
+ * Inserting and reading may run concurrently. Concurrent assignments to the same key are serialized
+ * by the busy flag, while their values are only consistent for readers after synchronization.
+ */
+template <typename Key, typename Value, typename Hash>
+class LockFreeHashMap
+{
+public:
+	struct Entry
+	{
+		unsigned int state;
+		Key key;
+		Value value;
+	};
+
+	//memory needs to be cleared once before use, afterwards reset is O(1)
+	LOCK_FREE_HASH_FUNCTION void init(int size, Entry* entries, unsigned int* generation)
+	{
+		_size = size;
+		_entries = entries;
+		_generation = generation;
+	}
+
+	LOCK_FREE_HASH_FUNCTION void clear()
+	{
+		for (int i = 0; i < _size; ++i) {
+			_entries[i].state = 0;
+		}
+		*_generation = 1;
+	}
+
+	LOCK_FREE_HASH_FUNCTION void reset()
+	{
+		if (*_generation == MaxGeneration) {
+			clear();
+			return;
+		}
+		++*_generation;
+	}
+
+	LOCK_FREE_HASH_FUNCTION int getSize() const { return _size; }
+
+	//returns true if key was present
+	LOCK_FREE_HASH_FUNCTION bool insertOrAssign(Key const& key, Value const& value)
+	{
+		auto const generationBits = *_generation << 2;
+		int index = _hash(key) % _size;
+		for (int i = 0; i < _size; ++i, index = (index + 1) % _size) {
+			auto& entry = _entries[index];
+			auto state = loadState(&entry.state);
+			if ((state & ~StateMask) != generationBits) {
+				if (compareAndSwapState(&entry.state, state, generationBits | Busy)) {
+					entry.key = key;
+					entry.value = value;
+					storeState(&entry.state, generationBits | Ready);
+					return false;
+				}
+				state = loadState(&entry.state);
+			}
+			while ((generationBits | Busy) == state) {
+				state = loadState(&entry.state);
+			}
+			if (entry.key == key) {
+				while (!compareAndSwapState(&entry.state, generationBits | Ready, generationBits | Busy)) {}
+				entry.value = value;
+				storeState(&entry.state, generationBits | Ready);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	LOCK_FREE_HASH_FUNCTION bool contains(Key const& key) const
+	{
+		return nullptr != find(key);
+	}
+
+	//returns Value() if key is not present
+	LOCK_FREE_HASH_FUNCTION Value at(Key const& key) const
+	{
+		if (auto entry = find(key)) {
+			return entry->value;
+		}
+		return Value();
+	}
+
+private:
+	LOCK_FREE_HASH_FUNCTION Entry const* find(Key const& key) const
+	{
+		auto const generationBits = *_generation << 2;
+		int index = _hash(key) % _size;
+		for (int i = 0; i < _size; ++i, index = (index + 1) % _size) {
+			auto const& entry = _entries[index];
+			auto state = loadState(&entry.state);
+			if ((state & ~StateMask) != generationBits) {
+				return nullptr;
+			}
+			while ((generationBits | Busy) == state) {
+				state = loadState(&entry.state);
+			}
+			if (entry.key == key) {
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	LOCK_FREE_HASH_FUNCTION static unsigned int loadState(unsigned int const* address)
+	{
+#ifdef __CUDA_ARCH__
+		auto const result = *reinterpret_cast<volatile unsigned int const*>(address);
+		__threadfence();
+		return result;
+#else
+		return reinterpret_cast<std::atomic<unsigned int> const*>(address)->load(std::memory_order_acquire);
+#endif
+	}
+
+	LOCK_FREE_HASH_FUNCTION static bool compareAndSwapState(unsigned int* address, unsigned int expected, unsigned int desired)
+	{
+#ifdef __CUDA_ARCH__
+		return expected == atomicCAS(address, expected, desired);
+#else
+		return reinterpret_cast<std::atomic<unsigned int>*>(address)->compare_exchange_strong(expected, desired, std::memory_order_acq_rel);
+#endif
+	}
+
+	LOCK_FREE_HASH_FUNCTION static void storeState(unsigned int* address, unsigned int value)
+	{
+#ifdef __CUDA_ARCH__
+		__threadfence();
+		atomicExch(address, value);
+#else
+		reinterpret_cast<std::atomic<unsigned int>*>(address)->store(value, std::memory_order_release);
+#endif
+	}
+
+	static unsigned int const Busy = 1;
+	static unsigned int const Ready = 2;
+	static unsigned int const StateMask = 3;
+	static unsigned int const MaxGeneration = (1u << 30) - 1;
+
+	int _size;
+	Entry* _entries;
+	unsigned int* _generation;
+	Hash _hash;
+};
+
+/**
+ * Lock-free hash set based on LockFreeHashMap.
+ */
+template <typename Key, typename Hash>
+class LockFreeHashSet
+{
+public:
+	struct Empty {};
+	using Entry = typename LockFreeHashMap<Key, Empty, Hash>::Entry;
+
+	LOCK_FREE_HASH_FUNCTION void init(int size, Entry* entries, unsigned int* generation)
+	{
+		_map.init(size, entries, generation);
+	}
+
+	LOCK_FREE_HASH_FUNCTION void clear() { _map.clear(); }
+	LOCK_FREE_HASH_FUNCTION void reset() { _map.reset(); }
+
+	//returns true if key was present
+	LOCK_FREE_HASH_FUNCTION bool insert(Key const& key) { return _map.insertOrAssign(key, Empty()); }
+
+	LOCK_FREE_HASH_FUNCTION bool contains(Key const& key) const { return _map.contains(key); }
+
+private:
+	LockFreeHashMap<Key, Empty, Hash> _map;
+};
@@ -16,7 +16,9 @@ public:
 	virtual uint32_t getRandomInt(uint32_t range) = 0;
 	virtual double getRandomReal(double min, double max) = 0;
 	virtual double getRandomReal() = 0;
+	virtual void getRandomReals(float* values, int count) = 0;	//same sequence as repeated calls of getRandomReal
 	virtual QByteArray getRandomArray(int length) = 0;
 
 	virtual uint64_t getId() = 0;
+	virtual uint64_t getIds(uint64_t count) = 0;	//reserves count consecutive ids and returns the first one
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+/**
+ * Executes func(0), ..., func(numTasks - 1) distributed over hardware threads.
+ * Small task counts are executed sequentially on the calling thread.
+ */
+template<typename Func>
+void executeInParallel(int numTasks, Func const& func, int minTasksPerThread = 16)
+{
+	int const numThreads = std::min(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())), numTasks / minTasksPerThread);
+	if (numThreads <= 1) {
+		for (int i = 0; i < numTasks; ++i) {
+			func(i);
+		}
+		return;
+	}
+
+	std::vector<std::future<void>> futures;
+	for (int thread = 0; thread < numThreads; ++thread) {
+		futures.emplace_back(std::async(std::launch::async, [&func, thread, numThreads, numTasks] {
+			for (int i = thread; i < numTasks; i += numThreads) {
+				func(i);
+			}
+		}));
+	}
+	for (auto& future : futures) {
+		future.get();
+	}
+}
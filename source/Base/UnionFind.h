@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Lock-free union-find for connected components. unite and findRoot may be called concurrently.
+ * Roots are always linked to the smaller index, so each component is represented by its smallest element
+ * independent of the order of the unite calls.
+ */
+class UnionFind
+{
+public:
+	UnionFind(int numElements)
+		: _numElements(numElements), _parents(new std::atomic<int>[numElements])
+	{
+		for (int index = 0; index < numElements; ++index) {
+			_parents[index].store(index, std::memory_order_relaxed);
+		}
+	}
+
+	int getNumElements() const { return _numElements; }
+
+	int findRoot(int index)
+	{
+		while (true) {
+			int parent = _parents[index].load(std::memory_order_relaxed);
+			if (parent == index) {
+				return index;
+			}
+
+			//path halving, a failed exchange only means that another thread shortened the path
+			int const grandParent = _parents[parent].load(std::memory_order_relaxed);
+			if (parent != grandParent) {
+				_parents[index].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+			}
+			index = grandParent;
+		}
+	}
+
+	void unite(int index1, int index2)
+	{
+		while (true) {
+			int root1 = findRoot(index1);
+			int root2 = findRoot(index2);
+			if (root1 == root2) {
+				return;
+			}
+			if (root1 < root2) {
+				std::swap(root1, root2);
+			}
+
+			//root1 can only be linked as long as it is still a root
+			int expected = root1;
+			if (_parents[root1].compare_exchange_strong(expected, root2, std::memory_order_acq_rel)) {
+				return;
+			}
+		}
+	}
+
+	//dense component indices in the order of the smallest elements, returns number of components
+	int getComponentIndices(std::vector<int>& result)
+	{
+		result.resize(_numElements);
+		int numComponents = 0;
+		for (int index = 0; index < _numElements; ++index) {
+			auto const root = findRoot(index);
+			result[index] = root == index ? numComponents++ : result[root];
+		}
+		return numComponents;
+	}
+
+private:
+	int _numElements;
+	std::unique_ptr<std::atomic<int>[]> _parents;
+};
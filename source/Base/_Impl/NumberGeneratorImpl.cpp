@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <sstream>
 #include <thread>
 #include "NumberGeneratorImpl.h"
@@ -42,6 +43,21 @@ double NumberGeneratorImpl::getRandomReal()
 	return static_cast<double>(getNumberFromArray()) / RAND_MAX;
 }
 
+void NumberGeneratorImpl::getRandomReals(float * values, int count)
+{
+	//values are copied in contiguous chunks of the array
+	int const arraySize = _arrayOfRandomNumbers.size();
+	for (int index = 0; index < count;) {
+		_index = (_index + 1) % arraySize;
+		int const chunkSize = std::min(count - index, arraySize - _index);
+		for (int chunkIndex = 0; chunkIndex < chunkSize; ++chunkIndex) {
+			values[index + chunkIndex] = static_cast<float>(static_cast<double>(_arrayOfRandomNumbers[_index + chunkIndex]) / RAND_MAX);
+		}
+		index += chunkSize;
+		_index += chunkSize - 1;
+	}
+}
+
 QByteArray NumberGeneratorImpl::getRandomArray(int length)
 {
 	QByteArray bytes;
@@ -57,6 +73,13 @@ uint64_t NumberGeneratorImpl::getId()
 	return _threadId | ++_runningNumber;
 }
 
+uint64_t NumberGeneratorImpl::getIds(uint64_t count)
+{
+	auto const result = _threadId | (_runningNumber + 1);
+	_runningNumber += count;
+	return result;
+}
+
 uint32_t NumberGeneratorImpl::getNumberFromArray()
 {
 	_index = (_index + 1) % _arrayOfRandomNumbers.size();
@@ -15,9 +15,11 @@ public:
 	virtual uint32_t getRandomInt(uint32_t range) override;
 	virtual double getRandomReal(double min, double max) override;
 	virtual double getRandomReal() override;
+	virtual void getRandomReals(float* values, int count) override;
 	virtual QByteArray getRandomArray(int length) override;
 
 	virtual uint64_t getId() override;
+	virtual uint64_t getIds(uint64_t count) override;
 
 private:
     uint32_t getLargeRandomInt(uint32_t range);
@@ -414,15 +414,13 @@ void ActionController::onSaveCollection()
 
 void ActionController::onCopyCollection()
 {
-	DataDescription copiedData = _repository->getExtendedSelection();
-	_model->setCopiedCollection(copiedData);
+	_model->setCopiedCollection(SharedDataDescription(_repository->getExtendedSelection()));
 	updateActionsEnableState();
 }
 
 void ActionController::onPasteCollection()
 {
-	DataDescription copiedData = _model->getCopiedCollection();
-	_repository->addAndSelectData(copiedData, _model->getPositionDeltaForNewEntity());
+	_repository->addAndSelectData(_model->getCopiedCollection().toDataDescription(), _model->getPositionDeltaForNewEntity());
 	Q_EMIT _notifier->notifyDataRepositoryChanged({
 		Receiver::DataEditor, Receiver::Simulation, Receiver::VisualEditor,Receiver::ActionController
 	}, UpdateDescription::All);
@@ -486,9 +484,8 @@ void ActionController::onRandomMultiplier()
 {
 	RandomMultiplierDialog dialog;
 	if (dialog.exec()) {
-		DataDescription data = _repository->getExtendedSelection();
+		DataDescription const data = _repository->getExtendedSelection();
 		IntVector2D universeSize = _mainController->getSimulationConfig()->universeSize;
-		vector<DataRepository::DataAndAngle> addedData;
 		for (int i = 0; i < dialog.getNumberOfCopies(); ++i) {
 			DataDescription dataCopied = data;
 			QVector2D posDelta(_numberGenerator->getRandomReal(0.0, universeSize.x), _numberGenerator->getRandomReal(0.0, universeSize.y));
@@ -509,9 +506,8 @@ void ActionController::onRandomMultiplier()
 				angularVelocity = _numberGenerator->getRandomReal(dialog.getAngVelMin(), dialog.getAngVelMax());
 			}
 			modifyDescription(dataCopied, posDelta, velocityX, velocityY, angularVelocity);
-			addedData.emplace_back(DataRepository::DataAndAngle{ dataCopied, angle });
+			_repository->addDataAtFixedPosition(std::move(dataCopied), angle);
 		}
-		_repository->addDataAtFixedPosition(addedData);
 		Q_EMIT _notifier->notifyDataRepositoryChanged({
 			Receiver::DataEditor,
 			Receiver::Simulation,
@@ -523,13 +519,12 @@ void ActionController::onRandomMultiplier()
 
 void ActionController::onGridMultiplier()
 {
-	DataDescription data = _repository->getExtendedSelection();
+	DataDescription const data = _repository->getExtendedSelection();
 	QVector2D center = data.calcCenter();
 	GridMultiplierDialog dialog(center);
 	if (dialog.exec()) {
 		QVector2D initialDelta(dialog.getInitialPosX(), dialog.getInitialPosY());
 		initialDelta -= center;
-		vector<DataRepository::DataAndAngle> addedData;
 		for (int i = 0; i < dialog.getHorizontalNumber(); ++i) {
 			for (int j = 0; j < dialog.getVerticalNumber(); ++j) {
 				if (i == 0 && j == 0 && initialDelta.lengthSquared() < FLOATINGPOINT_MEDIUM_PRECISION) {
@@ -557,10 +552,9 @@ void ActionController::onGridMultiplier()
 				posDelta += initialDelta;
 
 				modifyDescription(dataCopied, posDelta, velocityX, velocityY, angularVelocity);
-				addedData.emplace_back(DataRepository::DataAndAngle{ dataCopied, angle });
+				_repository->addDataAtFixedPosition(std::move(dataCopied), angle);
 			}
 		}
-		_repository->addDataAtFixedPosition(addedData);
 		Q_EMIT _notifier->notifyDataRepositoryChanged({
 			Receiver::DataEditor,
 			Receiver::Simulation,
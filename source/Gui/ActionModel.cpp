@@ -111,12 +111,12 @@ bool ActionModel::isCollectionCopied() const
 	return !_copiedCollection.isEmpty();
 }
 
-DataDescription const & ActionModel::getCopiedCollection() const
+SharedDataDescription const & ActionModel::getCopiedCollection() const
 {
 	return _copiedCollection;
 }
 
-void ActionModel::setCopiedCollection(DataDescription const &value)
+void ActionModel::setCopiedCollection(SharedDataDescription const &value)
 {
 	_copiedCollection = value;
 }
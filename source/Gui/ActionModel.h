@@ -3,6 +3,7 @@
 #include <QObject>
 
 #include "ModelBasic/Descriptions.h"
+#include "ModelBasic/SharedDescriptions.h"
 #include "Gui/Definitions.h"
 
 class ActionModel
@@ -40,8 +41,8 @@ public:
 	virtual void setCollectionSelected(bool value);
 
 	virtual bool isCollectionCopied() const;
-	virtual DataDescription const& getCopiedCollection() const;
-	virtual void setCopiedCollection(DataDescription const& value);
+	virtual SharedDataDescription const& getCopiedCollection() const;
+	virtual void setCopiedCollection(SharedDataDescription const& value);
 
 	virtual TokenDescription const& getCopiedToken() const;
 	virtual void setCopiedToken(TokenDescription const& value);
@@ -57,7 +58,7 @@ private:
 	bool _cellWithFreeTokenSelected = false;
 	bool _collectionSelected = false;
 
-	DataDescription _copiedCollection;
+	SharedDataDescription _copiedCollection;
 	DataDescription _copiedEntity;
 	optional<TokenDescription> _copiedToken;
 };
\ No newline at end of file
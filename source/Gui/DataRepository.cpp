@@ -21,6 +21,8 @@ void DataRepository::init(Notifier* notifier, SimulationAccess * access, Descrip
 	_parameters = context->getSimulationParameters();
 	_universeSize = context->getSpaceProperties()->getSize();
 	_unchangedData.clear();
+	_unchangedNavi = DescriptionNavigator();
+	_edits = DescriptionEdits();
 	_data.clear();
 	_selectedCellIds.clear();
 	_selectedClusterIds.clear();
@@ -36,6 +38,12 @@ void DataRepository::init(Notifier* notifier, SimulationAccess * access, Descrip
 }
 
 DataDescription & DataRepository::getDataRef()
+{
+	_edits.markAllEdited();
+	return _data;
+}
+
+DataDescription const & DataRepository::getDataRef() const
 {
 	return _data;
 }
@@ -47,10 +55,19 @@ CellDescription & DataRepository::getCellDescRef(uint64_t cellId)
 	return clusterDesc.cells->at(cellIndex);
 }
 
+CellDescription const & DataRepository::getCellDescRef(uint64_t cellId) const
+{
+	ClusterDescription const &clusterDesc = getClusterDescRef(cellId);
+	int cellIndex = _navi.cellIndicesByCellIds.at(cellId);
+	return clusterDesc.cells->at(cellIndex);
+}
+
 ClusterDescription & DataRepository::getClusterDescRef(uint64_t cellId)
 {
 	int clusterIndex = _navi.clusterIndicesByCellIds.at(cellId);
-	return _data.clusters->at(clusterIndex);
+	auto& cluster = _data.clusters->at(clusterIndex);
+	_edits.markClusterEdited(cluster.id);
+	return cluster;
 }
 
 ClusterDescription const & DataRepository::getClusterDescRef(uint64_t cellId) const
@@ -62,6 +79,7 @@ ClusterDescription const & DataRepository::getClusterDescRef(uint64_t cellId) co
 ParticleDescription& DataRepository::getParticleDescRef(uint64_t particleId)
 {
 	int particleIndex = _navi.particleIndicesByParticleIds.at(particleId);
+	_edits.markParticleEdited(particleId);
 	return _data.particles->at(particleIndex);
 }
 
@@ -92,11 +110,10 @@ void DataRepository::addAndSelectCell(QVector2D const & posDelta)
 			CellFeatureDescription().setType(Enums::CellFunction::COMPUTER).setVolatileData(QByteArray(memorySize, 0))
 		));
 	_descHelper->makeValid(desc);
-	_data.addCluster(desc);
+	addToData(desc);
 	_selectedCellIds = { desc.cells->front().id };
 	_selectedClusterIds = { desc.id };
 	_selectedParticleIds = { };
-	_navi.update(_data);
 }
 
 void DataRepository::addAndSelectParticle(QVector2D const & posDelta)
@@ -104,11 +121,10 @@ void DataRepository::addAndSelectParticle(QVector2D const & posDelta)
 	QVector2D pos = _rect.center().toQVector2D() + posDelta;
 	auto desc = ParticleDescription().setPos(pos).setVel({}).setEnergy(_parameters.cellMinEnergy / 2.0);
 	_descHelper->makeValid(desc);
-	_data.addParticle(desc);
+	addToData(desc);
 	_selectedCellIds = { };
 	_selectedClusterIds = { };
 	_selectedParticleIds = { desc.id };
-	_navi.update(_data);
 }
 
 void DataRepository::addAndSelectData(DataDescription data, QVector2D const & posDelta)
@@ -125,7 +141,7 @@ void DataRepository::addAndSelectData(DataDescription data, QVector2D const & po
 		for (auto& cluster : *data.clusters) {
 			cluster.id = 0;
 			_descHelper->makeValid(cluster);
-			_data.addCluster(cluster);
+			addToData(cluster);
 			_selectedClusterIds.insert(cluster.id);
 			if (cluster.cells) {
 				std::transform(cluster.cells->begin(), cluster.cells->end(), std::inserter(_selectedCellIds, _selectedCellIds.begin())
@@ -137,11 +153,10 @@ void DataRepository::addAndSelectData(DataDescription data, QVector2D const & po
 		for (auto& particle : *data.particles) {
 			particle.id = 0;
 			_descHelper->makeValid(particle);
-			_data.addParticle(particle);
+			addToData(particle);
 			_selectedParticleIds.insert(particle.id);
 		}
 	}
-	_navi.update(_data);
 }
 
 namespace
@@ -201,39 +216,34 @@ namespace
 	}
 }
 
-void DataRepository::addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles)
+void DataRepository::addDataAtFixedPosition(DataDescription data, optional<double> const& rotationAngle)
 {
-	for (auto & dataAndAngle : dataAndAngles) {
-		auto & data = dataAndAngle.data;
-		auto & rotationAngel = dataAndAngle.angle;
-		if (rotationAngel) {
-			int numClusters = data.clusters.is_initialized() ? data.clusters->size() : 0;
-			int numParticle = data.particles.is_initialized() ? data.particles->size() : 0;
-			auto clusterResolver = [&data](int index) -> ClusterDescription& {
-				return data.clusters->at(index);
-			};
-			auto particleResolver = [&data](int index) -> ParticleDescription& {
-				return data.particles->at(index);
-			};
-			rotate(*dataAndAngle.angle, numClusters, numParticle, clusterResolver, particleResolver);
-		}
+	if (rotationAngle) {
+		int numClusters = data.clusters.is_initialized() ? data.clusters->size() : 0;
+		int numParticle = data.particles.is_initialized() ? data.particles->size() : 0;
+		auto clusterResolver = [&data](int index) -> ClusterDescription& {
+			return data.clusters->at(index);
+		};
+		auto particleResolver = [&data](int index) -> ParticleDescription& {
+			return data.particles->at(index);
+		};
+		rotate(*rotationAngle, numClusters, numParticle, clusterResolver, particleResolver);
+	}
 
-		if (data.clusters) {
-			for (auto& cluster : *data.clusters) {
-				cluster.id = 0;
-				_descHelper->makeValid(cluster);
-				_data.addCluster(cluster);
-			}
+	if (data.clusters) {
+		for (auto& cluster : *data.clusters) {
+			cluster.id = 0;
+			_descHelper->makeValid(cluster);
+			addToData(std::move(cluster));
 		}
-		if (data.particles) {
-			for (auto& particle : *data.particles) {
-				particle.id = 0;
-				_descHelper->makeValid(particle);
-				_data.addParticle(particle);
-			}
+	}
+	if (data.particles) {
+		for (auto& particle : *data.particles) {
+			particle.id = 0;
+			_descHelper->makeValid(particle);
+			addToData(std::move(particle));
 		}
 	}
-	_navi.update(_data);
 }
 
 void DataRepository::addRandomParticles(double totalEnergy, double maxEnergyPerParticle)
@@ -250,7 +260,7 @@ void DataRepository::addRandomParticles(double totalEnergy, double maxEnergyPerP
 		remainingEnergy -= particleEnergy;
 	}
 
-	addDataAtFixedPosition({ { data, optional<double>() } });
+	addDataAtFixedPosition(std::move(data));
 }
 
 namespace
@@ -282,71 +292,56 @@ void DataRepository::deleteSelection()
 {
 	if (_data.clusters) {
 		unordered_set<uint64_t> modifiedClusterIds;
-		vector<ClusterDescription> newClusters;
-		for (auto const& cluster : *_data.clusters) {
-			if (_selectedClusterIds.find(cluster.id) == _selectedClusterIds.end()) {
-				newClusters.push_back(cluster);
+		for (uint64_t clusterId : _selectedClusterIds) {
+			auto clusterIndexIter = _navi.clusterIndicesByClusterIds.find(clusterId);
+			if (clusterIndexIter == _navi.clusterIndicesByClusterIds.end()) {
+				continue;
 			}
-			else if (cluster.cells) {
-				vector<CellDescription> newCells;
+			int clusterIndex = clusterIndexIter->second;
+			auto& cluster = _data.clusters->at(clusterIndex);
+			vector<CellDescription> newCells;
+			if (cluster.cells) {
 				for (auto const& cell : *cluster.cells) {
 					if (_selectedCellIds.find(cell.id) == _selectedCellIds.end()) {
 						newCells.push_back(cell);
 					}
 				}
-				if (!newCells.empty()) {
-					correctConnections(newCells);
-					ClusterDescription newCluster = cluster;
-					newCluster.cells = newCells;
-					newClusters.push_back(newCluster);
-					modifiedClusterIds.insert(cluster.id);
-				}
 			}
+			if (newCells.empty()) {
+				removeClusterFromData(clusterId);
+				continue;
+			}
+			correctConnections(newCells);
+			_navi.removeCluster(cluster);
+			cluster.cells = newCells;
+			_navi.addCluster(cluster, clusterIndex);
+			modifiedClusterIds.insert(cluster.id);
+			_edits.markClusterEdited(cluster.id);
 		}
-		_data.clusters = newClusters;
 		if (!modifiedClusterIds.empty()) {
-			_descHelper->recluster(_data, modifiedClusterIds);
+			markClustersEdited(_descHelper->recluster(_data, modifiedClusterIds));
+			_navi.update(_data);	//reclustering may split and reorder clusters
 		}
 	}
-	if (_data.particles) {
-		vector<ParticleDescription> newParticles;
-		for (auto const& particle : *_data.particles) {
-			if (_selectedParticleIds.find(particle.id) == _selectedParticleIds.end()) {
-				newParticles.push_back(particle);
-			}
-		}
-		_data.particles = newParticles;
+	for (uint64_t particleId : _selectedParticleIds) {
+		removeParticleFromData(particleId);
 	}
 	_selectedCellIds = {};
 	_selectedClusterIds = {};
 	_selectedParticleIds = {};
-	_navi.update(_data);
 }
 
 void DataRepository::deleteExtendedSelection()
 {
-	if (_data.clusters) {
-		vector<ClusterDescription> newClusters;
-		for (auto const& cluster : *_data.clusters) {
-			if (_selectedClusterIds.find(cluster.id) == _selectedClusterIds.end()) {
-				newClusters.push_back(cluster);
-			}
-		}
-		_data.clusters = newClusters;
+	for (uint64_t clusterId : _selectedClusterIds) {
+		removeClusterFromData(clusterId);
 	}
-	if (_data.particles) {
-		vector<ParticleDescription> newParticles;
-		for (auto const& particle : *_data.particles) {
-			if (_selectedParticleIds.find(particle.id) == _selectedParticleIds.end()) {
-				newParticles.push_back(particle);
-			}
-		}
-		_data.particles = newParticles;
+	for (uint64_t particleId : _selectedParticleIds) {
+		removeParticleFromData(particleId);
 	}
 	_selectedCellIds = {};
 	_selectedClusterIds = {};
 	_selectedParticleIds = {};
-	_navi.update(_data);
 }
 
 void DataRepository::addToken()
@@ -375,12 +370,12 @@ void DataRepository::deleteToken()
 	cell.delToken(*_selectedTokenIndex);
 }
 
-bool DataRepository::isCellPresent(uint64_t cellId)
+bool DataRepository::isCellPresent(uint64_t cellId) const
 {
 	return _navi.cellIds.find(cellId) != _navi.cellIds.end();
 }
 
-bool DataRepository::isParticlePresent(uint64_t particleId)
+bool DataRepository::isParticlePresent(uint64_t particleId) const
 {
 	return _navi.particleIds.find(particleId) != _navi.particleIds.end();
 }
@@ -397,9 +392,10 @@ void DataRepository::sendDataChangesToSimulation(set<Receiver> const& targets)
 	if (targets.find(Receiver::Simulation) == targets.end()) {
 		return;
 	}
-	DataChangeDescription delta(_unchangedData, _data);
+	DataChangeDescription delta(_unchangedData, _unchangedNavi, _data, _navi, _edits);
 	_access->updateData(delta);
-	_unchangedData = _data;
+	updateUnchangedData();
+	_edits = DescriptionEdits();
 }
 
 void DataRepository::setSelection(list<uint64_t> const &cellIds, list<uint64_t> const &particleIds)
@@ -518,24 +514,12 @@ void DataRepository::moveExtendedSelection(QVector2D const & delta)
 	for (uint64_t selectedClusterId : _selectedClusterIds) {
 		auto selectedClusterIndex = _navi.clusterIndicesByClusterIds.at(selectedClusterId);
 		ClusterDescription &clusterDesc = _data.clusters->at(selectedClusterIndex);
+		_edits.markClusterEdited(selectedClusterId);
 		clusterDesc.pos = *clusterDesc.pos + delta;
-	}
-
-	list<uint64_t> extSelectedCellIds;
-	for (auto clusterIdByCellId : _navi.clusterIdsByCellIds) {
-		uint64_t cellId = clusterIdByCellId.first;
-		uint64_t clusterId = clusterIdByCellId.second;
-		if (_selectedClusterIds.find(clusterId) != _selectedClusterIds.end()) {
-			extSelectedCellIds.push_back(cellId);
-		}
-	}
-
-	for (uint64_t cellId : extSelectedCellIds) {
-		if (isCellPresent(cellId)) {
-			int clusterIndex = _navi.clusterIndicesByCellIds.at(cellId);
-			int cellIndex = _navi.cellIndicesByCellIds.at(cellId);
-			CellDescription &cellDesc = getCellDescRef(cellId);
-			cellDesc.pos = *cellDesc.pos + delta;
+		if (clusterDesc.cells) {
+			for (auto& cellDesc : *clusterDesc.cells) {
+				cellDesc.pos = *cellDesc.pos + delta;
+			}
 		}
 	}
 
@@ -549,7 +533,7 @@ void DataRepository::moveExtendedSelection(QVector2D const & delta)
 
 void DataRepository::reconnectSelectedCells()
 {
-	_descHelper->reconnect(getDataRef(), _unchangedData, getSelectedCellIds());
+	markClustersEdited(_descHelper->reconnect(_data, _unchangedData, getSelectedCellIds()));
 	updateAfterCellReconnections();
 }
 
@@ -558,7 +542,9 @@ void DataRepository::rotateSelection(double angle)
 	vector<uint64_t> selectedClusterIds(_selectedClusterIds.begin(), _selectedClusterIds.end());
 	vector<uint64_t> selectedParticleIds(_selectedParticleIds.begin(), _selectedParticleIds.end());
 	auto clusterResolver = [&selectedClusterIds, this](int index) -> ClusterDescription&  {
-		return _data.clusters->at(_navi.clusterIndicesByClusterIds.at(selectedClusterIds.at(index)));
+		auto clusterId = selectedClusterIds.at(index);
+		_edits.markClusterEdited(clusterId);
+		return _data.clusters->at(_navi.clusterIndicesByClusterIds.at(clusterId));
 	};
 	auto particleResolver = [&selectedParticleIds, this](int index) -> ParticleDescription& {
 		return getParticleDescRef(selectedParticleIds.at(index));
@@ -569,17 +555,17 @@ void DataRepository::rotateSelection(double angle)
 void DataRepository::updateCluster(ClusterDescription const & cluster)
 {
 	int clusterIndex = _navi.clusterIndicesByClusterIds.at(cluster.id);
+	_navi.removeCluster(_data.clusters->at(clusterIndex));
 	_data.clusters->at(clusterIndex) = cluster;
-
-	_navi.update(_data);
+	_navi.addCluster(cluster, clusterIndex);
+	_edits.markClusterEdited(cluster.id);
 }
 
 void DataRepository::updateParticle(ParticleDescription const & particle)
 {
 	int particleIndex = _navi.particleIndicesByParticleIds.at(particle.id);
 	_data.particles->at(particleIndex) = particle;
-
-	_navi.update(_data);
+	_edits.markParticleEdited(particle.id);
 }
 
 void DataRepository::requireDataUpdateFromSimulation(IntRect const& rect)
@@ -601,6 +587,131 @@ std::mutex & DataRepository::getImageMutex()
     return _mutex;
 }
 
+void DataRepository::addToData(ClusterDescription cluster)
+{
+	_edits.markClusterEdited(cluster.id);
+	if (!_data.clusters) {
+		_data.clusters = vector<ClusterDescription>();
+	}
+	_data.clusters->emplace_back(std::move(cluster));
+	_navi.addCluster(_data.clusters->back(), _data.clusters->size() - 1);
+}
+
+void DataRepository::addToData(ParticleDescription particle)
+{
+	_edits.markParticleEdited(particle.id);
+	if (!_data.particles) {
+		_data.particles = vector<ParticleDescription>();
+	}
+	_data.particles->emplace_back(std::move(particle));
+	_navi.addParticle(_data.particles->back(), _data.particles->size() - 1);
+}
+
+void DataRepository::removeClusterFromData(uint64_t clusterId)
+{
+	auto clusterIndexIter = _navi.clusterIndicesByClusterIds.find(clusterId);
+	if (clusterIndexIter == _navi.clusterIndicesByClusterIds.end()) {
+		return;
+	}
+	_edits.markClusterEdited(clusterId);
+	int clusterIndex = clusterIndexIter->second;
+	auto& clusters = *_data.clusters;
+	_navi.removeCluster(clusters.at(clusterIndex));
+
+	//last cluster fills the gap => only its indices have to be updated
+	int lastIndex = clusters.size() - 1;
+	if (clusterIndex != lastIndex) {
+		clusters.at(clusterIndex) = std::move(clusters.back());
+		_navi.addCluster(clusters.at(clusterIndex), clusterIndex);
+	}
+	clusters.pop_back();
+}
+
+void DataRepository::removeParticleFromData(uint64_t particleId)
+{
+	auto particleIndexIter = _navi.particleIndicesByParticleIds.find(particleId);
+	if (particleIndexIter == _navi.particleIndicesByParticleIds.end()) {
+		return;
+	}
+	_edits.markParticleEdited(particleId);
+	int particleIndex = particleIndexIter->second;
+	auto& particles = *_data.particles;
+	_navi.removeParticle(particles.at(particleIndex));
+
+	int lastIndex = particles.size() - 1;
+	if (particleIndex != lastIndex) {
+		particles.at(particleIndex) = std::move(particles.back());
+		_navi.addParticle(particles.at(particleIndex), particleIndex);
+	}
+	particles.pop_back();
+}
+
+void DataRepository::markClustersEdited(unordered_set<uint64_t> const& clusterIds)
+{
+	for (uint64_t clusterId : clusterIds) {
+		_edits.markClusterEdited(clusterId);
+	}
+}
+
+namespace
+{
+	//replaces, adds or removes (if entity is null) the entity with given id, the last entity fills a gap
+	template<typename Description>
+	void updateEntity(vector<Description>& entities, FlatHashMap<uint64_t, int>& indicesByIds, uint64_t id, Description const* entity)
+	{
+		auto indexIt = indicesByIds.find(id);
+		if (entity) {
+			if (indexIt != indicesByIds.end()) {
+				entities.at(indexIt->second) = *entity;
+			}
+			else {
+				indicesByIds.insert_or_assign(id, static_cast<int>(entities.size()));
+				entities.emplace_back(*entity);
+			}
+			return;
+		}
+		if (indexIt == indicesByIds.end()) {
+			return;
+		}
+		int const index = indexIt->second;
+		indicesByIds.erase(id);
+		int const lastIndex = entities.size() - 1;
+		if (index != lastIndex) {
+			entities.at(index) = std::move(entities.back());
+			indicesByIds.insert_or_assign(entities.at(index).id, index);
+		}
+		entities.pop_back();
+	}
+}
+
+void DataRepository::updateUnchangedData()
+{
+	if (_edits.all) {
+		_unchangedData = _data;
+		_unchangedNavi = _navi;
+		return;
+	}
+
+	//only edited entities are copied
+	if (!_edits.clusterIds.empty() && !_unchangedData.clusters) {
+		_unchangedData.clusters = vector<ClusterDescription>();
+	}
+	for (uint64_t clusterId : _edits.clusterIds) {
+		auto clusterIndexIt = _navi.clusterIndicesByClusterIds.find(clusterId);
+		auto const cluster = clusterIndexIt != _navi.clusterIndicesByClusterIds.end() ? &_data.clusters->at(clusterIndexIt->second) : nullptr;
+		updateEntity(*_unchangedData.clusters, _unchangedNavi.clusterIndicesByClusterIds, clusterId, cluster);
+	}
+
+	if (!_edits.particleIds.empty() && !_unchangedData.particles) {
+		_unchangedData.particles = vector<ParticleDescription>();
+	}
+	for (uint64_t particleId : _edits.particleIds) {
+		auto particleIndexIt = _navi.particleIndicesByParticleIds.find(particleId);
+		auto const particle = particleIndexIt != _navi.particleIndicesByParticleIds.end() ? &_data.particles->at(particleIndexIt->second) : nullptr;
+		updateEntity(*_unchangedData.particles, _unchangedNavi.particleIndicesByParticleIds, particleId, particle);
+	}
+}
+
 void DataRepository::updateAfterCellReconnections()
 {
 	_navi.update(_data);
@@ -617,8 +728,10 @@ void DataRepository::updateInternals(DataDescription const &data)
 {
 	_data = data;
 	_unchangedData = _data;
+	_edits = DescriptionEdits();
 
 	_navi.update(data);
+	_unchangedNavi = _navi;
 
 	unordered_set<uint64_t> newSelectedCells;
 	std::copy_if(_selectedCellIds.begin(), _selectedCellIds.end(), std::inserter(newSelectedCells, newSelectedCells.begin()), 
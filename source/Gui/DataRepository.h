@@ -15,8 +15,11 @@ public:
 	virtual void init(Notifier* notifier, SimulationAccess* access, DescriptionHelper* connector
 		, SimulationContext* context);
 
+	//mutable access marks the returned entities as edited => prefer const access for reading
 	virtual DataDescription& getDataRef();
+	virtual DataDescription const& getDataRef() const;
 	virtual CellDescription& getCellDescRef(uint64_t cellId);
+	virtual CellDescription const& getCellDescRef(uint64_t cellId) const;
 	virtual ClusterDescription& getClusterDescRef(uint64_t cellId);
 	virtual ClusterDescription const& getClusterDescRef(uint64_t cellId) const;
 	virtual ParticleDescription& getParticleDescRef(uint64_t particleId);
@@ -28,11 +31,7 @@ public:
 	virtual void addAndSelectCell(QVector2D const& posDelta);
 	virtual void addAndSelectParticle(QVector2D const& posDelta);
 	virtual void addAndSelectData(DataDescription data, QVector2D const& posDelta);
-	struct DataAndAngle {
-		DataDescription data;
-		optional<double> angle;
-	};
-	virtual void addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles);
+	virtual void addDataAtFixedPosition(DataDescription data, optional<double> const& rotationAngle = boost::none);
 	virtual void addRandomParticles(double totalEnergy, double maxEnergyPerParticle);
 	virtual void deleteSelection();
 	virtual void deleteExtendedSelection();
@@ -56,7 +55,7 @@ public:
 	virtual unordered_set<uint64_t> getSelectedCellIds() const;
 	virtual unordered_set<uint64_t> getSelectedParticleIds() const;
 	virtual DataDescription getExtendedSelection() const;
-	virtual bool isCellPresent(uint64_t cellId);
+	virtual bool isCellPresent(uint64_t cellId) const;
 
 	virtual void requireDataUpdateFromSimulation(IntRect const& rect);
 	virtual void requireImageFromSimulation(IntRect const& rect, QImagePtr const& target);
@@ -69,9 +68,15 @@ private:
 	Q_SLOT void dataFromSimulationAvailable();
 	Q_SLOT void sendDataChangesToSimulation(set<Receiver> const& targets);
 
+	void addToData(ClusterDescription cluster);
+	void addToData(ParticleDescription particle);
+	void removeClusterFromData(uint64_t clusterId);
+	void removeParticleFromData(uint64_t particleId);
+	void markClustersEdited(unordered_set<uint64_t> const& clusterIds);
+	void updateUnchangedData();
 	void updateAfterCellReconnections();
 	void updateInternals(DataDescription const &data);
-	bool isParticlePresent(uint64_t particleId);
+	bool isParticlePresent(uint64_t particleId) const;
 
 	list<QMetaObject::Connection> _connections;
 
@@ -82,6 +87,8 @@ private:
 	NumberGenerator* _numberGenerator = nullptr;
 	DataDescription _data;
 	DataDescription _unchangedData;
+	DescriptionNavigator _unchangedNavi;	//only cluster and particle indices are kept up to date
+	DescriptionEdits _edits;	//since _unchangedData
 
 	optional<uint> _selectedTokenIndex;
 	unordered_set<uint64_t> _selectedCellIds;
@@ -15,14 +15,28 @@ ImageSectionItem::~ImageSectionItem()
 {
 }
 
+IntRect ImageSectionItem::getVisibleRect() const
+{
+    auto const viewportRect = _viewport->getRect();
+    IntVector2D upperLeft{ std::max(0, static_cast<int>(viewportRect.x())), std::max(0, static_cast<int>(viewportRect.y())) };
+    IntVector2D viewportSize{ static_cast<int>(viewportRect.width()), static_cast<int>(viewportRect.height()) };
+    viewportSize.x = std::min(static_cast<int>(_boundingRect.width()) - upperLeft.x, viewportSize.x);
+    viewportSize.y = std::min(static_cast<int>(_boundingRect.height()) - upperLeft.y, viewportSize.y);
+    return{ upperLeft, { upperLeft.x + std::max(1, viewportSize.x) - 1, upperLeft.y + std::max(1, viewportSize.y) - 1 } };
+}
+
 QImagePtr ImageSectionItem::getImageOfVisibleRect()
 {
+    //image resolution is limited by the view => zoomed out universes are rendered downscaled
+    auto const rect = getVisibleRect();
+    auto const viewSize = _viewport->getViewSize();
+    IntVector2D imageSize{ rect.p2.x - rect.p1.x + 1, rect.p2.y - rect.p1.y + 1 };
+    imageSize.x = std::max(1, std::min(viewSize.x, imageSize.x));
+    imageSize.y = std::max(1, std::min(viewSize.y, imageSize.y));
+
     //resize image?
-    IntVector2D viewportSize{ static_cast<int>(_viewport->getRect().width()), static_cast<int>(_viewport->getRect().height()) };
-    viewportSize.x = std::min(static_cast<int>(_boundingRect.width()), viewportSize.x);
-    viewportSize.y = std::min(static_cast<int>(_boundingRect.height()), viewportSize.y);
-    if (_imageOfVisibleRect->width() != viewportSize.x || _imageOfVisibleRect->height() != viewportSize.y) {
-        _imageOfVisibleRect = boost::make_shared<QImage>(viewportSize.x, viewportSize.y, QImage::Format_ARGB32);
+    if (_imageOfVisibleRect->width() != imageSize.x || _imageOfVisibleRect->height() != imageSize.y) {
+        _imageOfVisibleRect = boost::make_shared<QImage>(imageSize.x, imageSize.y, QImage::Format_ARGB32);
         _imageOfVisibleRect->fill(QColor(0, 0, 0));
     }
 
@@ -36,13 +50,17 @@ QRectF ImageSectionItem::boundingRect() const
 
 void ImageSectionItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget /*= Q_NULLPTR*/)
 {
-    auto const viewportRect = _viewport->getRect();
+    auto const rect = getVisibleRect();
 
-    std::lock_guard<std::mutex> lock(_mutex);
+    //front buffer is only shallow-copied under the lock since the worker swaps in completed frames
+    QImage frontImage;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        frontImage = *_imageOfVisibleRect;
+    }
 
     painter->drawImage(
-        std::max(0.0f, static_cast<float>(viewportRect.x())),
-        std::max(0.0f, static_cast<float>(viewportRect.y())),
-        *_imageOfVisibleRect);
+        QRectF(rect.p1.x, rect.p1.y, rect.p2.x - rect.p1.x + 1, rect.p2.y - rect.p1.y + 1),
+        frontImage);
 }
 
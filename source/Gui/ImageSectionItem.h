@@ -11,6 +11,7 @@ public:
     ImageSectionItem(ViewportInterface* viewport, QRectF const& boundingRect, std::mutex& mutex);
     ~ImageSectionItem();
 
+    IntRect getVisibleRect() const;
     QImagePtr getImageOfVisibleRect();
     QRectF boundingRect() const override;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = Q_NULLPTR) override;
@@ -33,7 +33,7 @@ void ItemManager::activate(IntVector2D size)
 	_connectionsByIds.clear();
 }
 
-void ItemManager::updateCells(DataRepository* dataController)
+void ItemManager::updateCells(DataRepository const* dataController)
 {
 	auto const &data = dataController->getDataRef();
 
@@ -72,7 +72,7 @@ void ItemManager::updateCells(DataRepository* dataController)
 	_cellsByIds = newCellsByIds;
 }
 
-void ItemManager::updateParticles(DataRepository* manipulator)
+void ItemManager::updateParticles(DataRepository const* manipulator)
 {
 	auto const &data = manipulator->getDataRef();
 
@@ -106,7 +106,7 @@ void ItemManager::updateParticles(DataRepository* manipulator)
 	_particlesByIds = newParticlesByIds;
 }
 
-void ItemManager::updateConnections(DataRepository* repository)
+void ItemManager::updateConnections(DataRepository const* repository)
 {
 	auto const &data = repository->getDataRef();
 	if (!data.clusters) {
@@ -123,7 +123,7 @@ void ItemManager::updateConnections(DataRepository* repository)
 				if (!repository->isCellPresent(connectingCellId)) {
 					continue;
 				}
-				auto &connectingCellD = repository->getCellDescRef(connectingCellId);
+				auto const &connectingCellD = repository->getCellDescRef(connectingCellId);
 				set<uint64_t> connectionId;
 				connectionId.insert(cell.id);
 				connectionId.insert(connectingCellId);
@@ -27,9 +27,9 @@ public:
 	virtual void toggleCellInfo(bool showInfo);
 
 private:
-	void updateCells(DataRepository* visualDesc);
-	void updateConnections(DataRepository* visualDesc);
-	void updateParticles(DataRepository* visualDesc);
+	void updateCells(DataRepository const* visualDesc);
+	void updateConnections(DataRepository const* visualDesc);
+	void updateParticles(DataRepository const* visualDesc);
 		
 	QGraphicsScene* _scene = nullptr;
 	ViewportInterface* _viewport = nullptr;
@@ -41,7 +41,7 @@ void VersionController::loadSimulationContentFromStack()
 		return;
 	}
 	_access->clear();
-	_access->updateData(_stack.back().data);
+	_access->updateData(_stack.back().data.toDataDescription());
 	_stack.pop_back();
 }
 
@@ -63,7 +63,7 @@ void VersionController::restoreSnapshot()
 		return;
 	}
 	_access->clear();
-	_access->updateData(_snapshot->data);
+	_access->updateData(_snapshot->data.unpack());
     _context->setTimestep(_snapshot->timestep);
 }
 
@@ -74,10 +74,11 @@ void VersionController::dataReadyToRetrieve()
 	}
     auto const timestep = _context->getTimestep();
 	if (*_target == TargetForReceivedData::Stack) {
-        _stack.emplace_back(SnapshotData{ _access->retrieveData(), timestep });
+        auto const previousData = _stack.empty() ? SharedDataDescription() : _stack.back().data;
+        _stack.emplace_back(StackData{ SharedDataDescription(_access->retrieveData(), previousData), timestep });
 	}
 	if (*_target == TargetForReceivedData::Snapshot) {
-        _snapshot = SnapshotData{ _access->retrieveData(), timestep };
+        _snapshot = SnapshotData{ PackedDataDescription(_access->retrieveData()), timestep };
 	}
 	_target.reset();
 }
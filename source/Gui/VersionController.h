@@ -2,7 +2,8 @@
 
 #include <QObject>
 
-#include "ModelBasic/Descriptions.h"
+#include "ModelBasic/PackedDescriptions.h"
+#include "ModelBasic/SharedDescriptions.h"
 #include "Definitions.h"
 
 class VersionController
@@ -35,9 +36,14 @@ private:
 	optional<TargetForReceivedData> _target;
     struct SnapshotData
     {
-        DataDescription data;
+        PackedDataDescription data;    //whole universe, kept packed until restored
         int timestep;
     };
-	list<SnapshotData> _stack;
+    struct StackData
+    {
+        SharedDataDescription data;    //unchanged clusters are shared with the previous entry
+        int timestep;
+    };
+	list<StackData> _stack;
 	optional<SnapshotData> _snapshot;
 };
@@ -53,6 +53,11 @@ QRectF ViewportController::getRect() const
 	return{ p1, p2 };
 }
 
+IntVector2D ViewportController::getViewSize() const
+{
+	return{ _view->width(), _view->height() };
+}
+
 QVector2D ViewportController::getCenter() const
 {
 	QPointF centerPoint = _view->mapToScene(_view->width() / 2, _view->height() / 2);
@@ -20,6 +20,7 @@ public:
 	virtual ActiveScene getActiveScene() const;
 
 	virtual QRectF getRect() const override;
+	virtual IntVector2D getViewSize() const override;
 	virtual QVector2D getCenter() const override;
 
     virtual void zoom(double factor, bool notify = true);
@@ -14,6 +14,7 @@ public:
 	virtual void setModeToNoUpdate() = 0;
 
 	virtual QRectF getRect() const = 0;
+	virtual IntVector2D getViewSize() const = 0;	//in screen pixels
 	virtual QVector2D getCenter() const = 0;
 
 	virtual void scrollToPos(QVector2D pos, NotifyScrollChanged notify) = 0;
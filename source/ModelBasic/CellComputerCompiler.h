@@ -19,6 +19,8 @@ public:
 	virtual ~CellComputerCompiler() = default;
 
 	virtual CompilationResult compileSourceCode(std::string const& code) const = 0;
+	//compiles equal sources only once and distributes the work over several threads
+	virtual vector<CompilationResult> compileSourceCodes(vector<std::string> const& codes) const = 0;
 	virtual std::string decompileSourceCode(QByteArray const& data) const = 0;
 };
 
@@ -1,10 +1,14 @@
-﻿#include "SymbolTable.h"
+﻿#include "Base/Parallel.h"
+
+#include "SymbolTable.h"
 #include "SimulationParameters.h"
 #include "CompilerHelper.h"
 #include "CellComputerCompilerImpl.h"
 
 namespace
 {
+	int const MaxCacheSize = 10000;
+
 	enum class CompilerState {
 		LOOKING_FOR_INSTR_START,
 		LOOKING_FOR_INSTR_END,
@@ -275,9 +279,102 @@ void CellComputerCompilerImpl::init(SymbolTable const* symbols, SimulationParame
 {
 	_symbols = symbols;
 	_parameters = parameters;
+
+	std::lock_guard<std::mutex> lock(_cacheMutex);
+	_cache.clear();
 }
 
 CompilationResult CellComputerCompilerImpl::compileSourceCode(std::string const & code) const
+{
+	uint64_t symbolsVersion;
+	{
+		std::lock_guard<std::mutex> lock(_cacheMutex);
+		validateCache();
+		auto cacheIt = _cache.find(code);
+		if (cacheIt != _cache.end()) {
+			return cacheIt->second;
+		}
+		symbolsVersion = _cacheSymbolsVersion;
+	}
+
+	auto result = compileSourceCodeUncached(code);
+
+	std::lock_guard<std::mutex> lock(_cacheMutex);
+	addToCache(symbolsVersion, code, result);
+	return result;
+}
+
+vector<CompilationResult> CellComputerCompilerImpl::compileSourceCodes(vector<std::string> const & codes) const
+{
+	vector<CompilationResult> result(codes.size());
+
+	//only the first occurrence of each uncached source is compiled, the others refer to it
+	vector<int> indicesToCompile;
+	vector<int> sourceIndices(codes.size(), -1);
+	uint64_t symbolsVersion;
+	{
+		std::lock_guard<std::mutex> lock(_cacheMutex);
+		validateCache();
+		symbolsVersion = _cacheSymbolsVersion;
+
+		unordered_map<std::string, int> firstIndicesBySource;
+		for (int index = 0; index < codes.size(); ++index) {
+			auto const& code = codes[index];
+			auto cacheIt = _cache.find(code);
+			if (cacheIt != _cache.end()) {
+				result[index] = cacheIt->second;
+				continue;
+			}
+			auto insertResult = firstIndicesBySource.emplace(code, index);
+			if (insertResult.second) {
+				indicesToCompile.emplace_back(index);
+			}
+			else {
+				sourceIndices[index] = insertResult.first->second;
+			}
+		}
+	}
+
+	executeInParallel(indicesToCompile.size(), [&](int index) {
+		auto const codeIndex = indicesToCompile[index];
+		result[codeIndex] = compileSourceCodeUncached(codes[codeIndex]);
+	}, 4);
+
+	{
+		std::lock_guard<std::mutex> lock(_cacheMutex);
+		for (auto const& index : indicesToCompile) {
+			addToCache(symbolsVersion, codes[index], result[index]);
+		}
+	}
+	for (int index = 0; index < codes.size(); ++index) {
+		if (sourceIndices[index] != -1) {
+			result[index] = result[sourceIndices[index]];
+		}
+	}
+	return result;
+}
+
+void CellComputerCompilerImpl::validateCache() const
+{
+	auto const symbolsVersion = _symbols->getVersion();
+	if (symbolsVersion != _cacheSymbolsVersion) {
+		_cache.clear();
+		_cacheSymbolsVersion = symbolsVersion;
+	}
+}
+
+void CellComputerCompilerImpl::addToCache(uint64_t symbolsVersion, std::string const & code, CompilationResult const & result) const
+{
+	if (symbolsVersion != _cacheSymbolsVersion) {
+		return;
+	}
+	if (_cache.size() >= MaxCacheSize) {
+		_cache.clear();
+	}
+	_cache.emplace(code, result);
+}
+
+CompilationResult CellComputerCompilerImpl::compileSourceCodeUncached(std::string const & code) const
 {
 	CompilerState state = CompilerState::LOOKING_FOR_INSTR_START;
 
@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include <mutex>
+
 #include "Definitions.h"
 #include "CellComputerCompiler.h"
 
@@ -14,9 +16,21 @@ public:
 	void init(SymbolTable const* symbols, SimulationParameters const& parameters);
 
 	virtual CompilationResult compileSourceCode(std::string const& code) const override;
+	virtual vector<CompilationResult> compileSourceCodes(vector<std::string> const& codes) const override;
 	virtual std::string decompileSourceCode(QByteArray const& data) const override;
 
 private:
+	CompilationResult compileSourceCodeUncached(std::string const& code) const;
+
+	//cache access requires locked _cacheMutex
+	void validateCache() const;
+	void addToCache(uint64_t symbolsVersion, std::string const& code, CompilationResult const& result) const;
+
 	SymbolTable const* _symbols = nullptr;
 	SimulationParameters _parameters;
+
+	//compilations by source code, valid as long as the symbol table is unchanged
+	mutable std::mutex _cacheMutex;
+	mutable uint64_t _cacheSymbolsVersion = 0;
+	mutable unordered_map<std::string, CompilationResult> _cache;
 };
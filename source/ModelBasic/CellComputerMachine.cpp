@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+#include "Base/Parallel.h"
+
+#include "CompilerHelper.h"
+#include "CellComputerMachine.h"
+
+namespace
+{
+	int const MaxLocalConditions = 32;
+}
+
+CellComputerProgram::CellComputerProgram(QByteArray const & code, SimulationParameters const & parameters)
+	: _tokenMemorySize(parameters.tokenMemorySize)
+{
+	auto const cellMemorySize = static_cast<uint32_t>(parameters.cellFunctionComputerCellMemorySize);
+	auto getByte = [&code](int index) {
+		return index < code.size() ? code[index] : static_cast<char>(0);
+	};
+	auto getMemorySize = [&](uint8_t opType) {
+		return opType == Enums::ComputerOptype::CMEM ? cellMemorySize : _tokenMemorySize;
+	};
+
+	//machine code: [INSTR - 4 Bits][MEM/MEMMEM/CMEM - 2 Bit][MEM/MEMMEM/CMEM/CONST - 2 Bit]
+	int const numBytes = std::min(code.size(), parameters.cellFunctionComputerMaxInstructions * 3);
+	_instructions.reserve((numBytes + 2) / 3);
+	for (int instructionPointer = 0; instructionPointer < numBytes; instructionPointer += 3) {
+		auto const opCode = static_cast<uint8_t>(getByte(instructionPointer));
+		Instruction instruction;
+		instruction.operation = (opCode >> 4) & 0xF;
+		instruction.opType1 = ((opCode >> 2) & 0x3) % 3;
+		instruction.opType2 = opCode & 0x3;
+		instruction.operand1 = CompilerHelper::convertToAddress(getByte(instructionPointer + 1), getMemorySize(instruction.opType1));
+		instruction.operand2 = instruction.opType2 == Enums::ComputerOptype::CONSTANT
+			? static_cast<uint8_t>(getByte(instructionPointer + 2))
+			: CompilerHelper::convertToAddress(getByte(instructionPointer + 2), getMemorySize(instruction.opType2));
+		if (instruction.operation >= Enums::ComputerOperation::IFG && instruction.operation <= Enums::ComputerOperation::IFL) {
+			++_numConditions;
+		}
+		_instructions.emplace_back(instruction);
+	}
+}
+
+void CellComputerProgram::execute(char * tokenMemory, char * cellMemory) const
+{
+	char localConditions[MaxLocalConditions];
+	std::unique_ptr<char[]> heapConditions;
+	char* conditions = localConditions;
+	if (_numConditions > MaxLocalConditions) {
+		heapConditions.reset(new char[_numConditions]);
+		conditions = heapConditions.get();
+	}
+	int numConditions = 0;
+	int numFalseConditions = 0;
+	auto pushCondition = [&](bool value) {
+		conditions[numConditions++] = value;
+		if (!value) {
+			++numFalseConditions;
+		}
+	};
+
+	for (auto const& instruction : _instructions) {
+
+		//operand 1: reference to memory
+		char* memory1 = tokenMemory;
+		uint8_t pointer1 = instruction.operand1;
+		switch (instruction.opType1) {
+		case Enums::ComputerOptype::MEMMEM:
+			pointer1 = CompilerHelper::convertToAddress(tokenMemory[instruction.operand1], _tokenMemorySize);
+			break;
+		case Enums::ComputerOptype::CMEM:
+			memory1 = cellMemory;
+			break;
+		}
+		char& value1 = memory1[pointer1];
+
+		//operand 2: value
+		uint8_t value2 = instruction.operand2;
+		switch (instruction.opType2) {
+		case Enums::ComputerOptype::MEM:
+			value2 = tokenMemory[instruction.operand2];
+			break;
+		case Enums::ComputerOptype::MEMMEM:
+			value2 = tokenMemory[CompilerHelper::convertToAddress(tokenMemory[instruction.operand2], _tokenMemorySize)];
+			break;
+		case Enums::ComputerOptype::CMEM:
+			value2 = cellMemory[instruction.operand2];
+			break;
+		}
+
+		bool const execute = 0 == numFalseConditions;
+		switch (instruction.operation) {
+		case Enums::ComputerOperation::MOV:
+			if (execute) {
+				value1 = value2;
+			}
+			break;
+		case Enums::ComputerOperation::ADD:
+			if (execute) {
+				value1 = static_cast<int8_t>(value1) + value2;
+			}
+			break;
+		case Enums::ComputerOperation::SUB:
+			if (execute) {
+				value1 = static_cast<int8_t>(value1) - value2;
+			}
+			break;
+		case Enums::ComputerOperation::MUL:
+			if (execute) {
+				value1 = static_cast<int8_t>(value1) * value2;
+			}
+			break;
+		case Enums::ComputerOperation::DIV:
+			if (execute) {
+				value1 = value2 > 0 ? static_cast<int8_t>(value1) / value2 : 0;
+			}
+			break;
+		case Enums::ComputerOperation::XOR:
+			if (execute) {
+				value1 = static_cast<int8_t>(value1) ^ value2;
+			}
+			break;
+		case Enums::ComputerOperation::OR:
+			if (execute) {
+				value1 = static_cast<int8_t>(value1) | value2;
+			}
+			break;
+		case Enums::ComputerOperation::AND:
+			if (execute) {
+				value1 = static_cast<int8_t>(value1) & value2;
+			}
+			break;
+
+		//conditions are evaluated also in non-executed branches (comparison is unsigned as on device)
+		case Enums::ComputerOperation::IFG:
+			pushCondition(static_cast<uint8_t>(value1) > value2);
+			break;
+		case Enums::ComputerOperation::IFGE:
+			pushCondition(static_cast<uint8_t>(value1) >= value2);
+			break;
+		case Enums::ComputerOperation::IFE:
+			pushCondition(static_cast<uint8_t>(value1) == value2);
+			break;
+		case Enums::ComputerOperation::IFNE:
+			pushCondition(static_cast<uint8_t>(value1) != value2);
+			break;
+		case Enums::ComputerOperation::IFLE:
+			pushCondition(static_cast<uint8_t>(value1) <= value2);
+			break;
+		case Enums::ComputerOperation::IFL:
+			pushCondition(static_cast<uint8_t>(value1) < value2);
+			break;
+		case Enums::ComputerOperation::ELSE:
+			if (numConditions > 0) {
+				auto& condition = conditions[numConditions - 1];
+				numFalseConditions += condition ? 1 : -1;
+				condition = !condition;
+			}
+			break;
+		case Enums::ComputerOperation::ENDIF:
+			if (numConditions > 0) {
+				if (!conditions[--numConditions]) {
+					--numFalseConditions;
+				}
+			}
+			break;
+		}
+	}
+}
+
+CellComputerMachine::CellComputerMachine(SimulationParameters const & parameters)
+	: _parameters(parameters)
+{
+}
+
+CellComputerProgram const & CellComputerMachine::getProgram(uint64_t cellId, QByteArray const & code)
+{
+	auto& cachedProgram = _programsByCellIds[cellId];
+	if (cachedProgram.code != code) {
+		cachedProgram.code = code;
+		cachedProgram.program = CellComputerProgram(code, _parameters);
+	}
+	return cachedProgram.program;
+}
+
+void CellComputerMachine::removeProgram(uint64_t cellId)
+{
+	_programsByCellIds.erase(cellId);
+}
+
+void CellComputerMachine::execute(vector<Execution> const & executions)
+{
+	int const numExecutions = executions.size();
+
+	//decoding modifies the cache and is therefore done beforehand
+	vector<CellComputerProgram const*> programs(numExecutions);
+	for (int index = 0; index < numExecutions; ++index) {
+		programs[index] = &getProgram(executions[index].cellId, *executions[index].code);
+	}
+
+	//executions are grouped by cell memory since they may modify it
+	vector<int> order(numExecutions);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&executions](int index1, int index2) {
+		return std::less<char*>()(executions[index1].cellMemory, executions[index2].cellMemory);
+	});
+	vector<int> groupStarts;
+	for (int orderIndex = 0; orderIndex < numExecutions; ++orderIndex) {
+		if (0 == orderIndex || executions[order[orderIndex]].cellMemory != executions[order[orderIndex - 1]].cellMemory) {
+			groupStarts.emplace_back(orderIndex);
+		}
+	}
+	groupStarts.emplace_back(numExecutions);
+
+	executeInParallel(groupStarts.size() - 1, [&](int group) {
+		for (int orderIndex = groupStarts[group]; orderIndex < groupStarts[group + 1]; ++orderIndex) {
+			auto const index = order[orderIndex];
+			programs[index]->execute(executions[index].tokenMemory, executions[index].cellMemory);
+		}
+	}, 256);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Cell computer code which is decoded once into a compact instruction array.
+ * Execution follows the semantics of CellComputerFunction on device.
+ */
+class MODELBASIC_EXPORT CellComputerProgram
+{
+public:
+	CellComputerProgram() = default;
+	CellComputerProgram(QByteArray const& code, SimulationParameters const& parameters);
+
+	int getNumInstructions() const { return _instructions.size(); }
+
+	//tokenMemory and cellMemory need to hold tokenMemorySize and cellFunctionComputerCellMemorySize bytes
+	void execute(char* tokenMemory, char* cellMemory) const;
+
+private:
+	struct Instruction
+	{
+		uint8_t operation;
+		uint8_t opType1;
+		uint8_t opType2;
+		uint8_t operand1;	//address (token memory for MEMMEM)
+		uint8_t operand2;	//address unless opType2 is CONSTANT
+	};
+	vector<Instruction> _instructions;
+	int _numConditions = 0;
+	uint32_t _tokenMemorySize = 0;
+};
+
+/**
+ * Host-side cell computer. Decoded programs are cached per cell until the cell's code changes.
+ */
+class MODELBASIC_EXPORT CellComputerMachine
+{
+public:
+	CellComputerMachine(SimulationParameters const& parameters);
+
+	CellComputerProgram const& getProgram(uint64_t cellId, QByteArray const& code);
+	void removeProgram(uint64_t cellId);
+
+	struct Execution
+	{
+		uint64_t cellId;
+		QByteArray const* code;
+		char* tokenMemory;
+		char* cellMemory;
+	};
+	//executions on the same cell memory are performed in the given order, all others in parallel
+	void execute(vector<Execution> const& executions);
+
+private:
+	struct CachedProgram
+	{
+		QByteArray code;
+		CellComputerProgram program;
+	};
+
+	SimulationParameters _parameters;
+	unordered_map<uint64_t, CachedProgram> _programsByCellIds;
+};
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "ChangeDescriptions.h"
 
 CellChangeDescription::CellChangeDescription(CellDescription const & desc)
@@ -223,4 +225,70 @@ DataChangeDescription::DataChangeDescription(DataDescription const & dataBefore,
 	}
 }
 
+namespace
+{
+	vector<uint64_t> getSortedIds(unordered_set<uint64_t> const& ids)
+	{
+		vector<uint64_t> result(ids.begin(), ids.end());
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+}
 
+DataChangeDescription::DataChangeDescription(DataDescription const & dataBefore, DescriptionNavigator const & naviBefore
+	, DataDescription const & dataAfter, DescriptionNavigator const & naviAfter, DescriptionEdits const & edits)
+{
+	if (edits.all) {
+		*this = DataChangeDescription(dataBefore, dataAfter);
+		return;
+	}
+
+	//deleted and modified entities are added before new entities as in the comparison of the whole data
+	vector<ClusterDescription const*> newClusters;
+	for (uint64_t clusterId : getSortedIds(edits.clusterIds)) {
+		auto beforeIt = naviBefore.clusterIndicesByClusterIds.find(clusterId);
+		auto afterIt = naviAfter.clusterIndicesByClusterIds.find(clusterId);
+		bool const isBefore = beforeIt != naviBefore.clusterIndicesByClusterIds.end();
+		bool const isAfter = afterIt != naviAfter.clusterIndicesByClusterIds.end();
+		if (isBefore && isAfter) {
+			ClusterChangeDescription change(dataBefore.clusters->at(beforeIt->second), dataAfter.clusters->at(afterIt->second));
+			if (!change.isEmpty()) {
+				addModifiedCluster(change);
+			}
+		}
+		else if (isBefore) {
+			auto const& clusterBefore = dataBefore.clusters->at(beforeIt->second);
+			addDeletedCluster(ClusterChangeDescription().setId(clusterBefore.id).setPos(*clusterBefore.pos));
+		}
+		else if (isAfter) {
+			newClusters.emplace_back(&dataAfter.clusters->at(afterIt->second));
+		}
+	}
+	for (auto const& cluster : newClusters) {
+		addNewCluster(ClusterChangeDescription(*cluster));
+	}
+
+	vector<ParticleDescription const*> newParticles;
+	for (uint64_t particleId : getSortedIds(edits.particleIds)) {
+		auto beforeIt = naviBefore.particleIndicesByParticleIds.find(particleId);
+		auto afterIt = naviAfter.particleIndicesByParticleIds.find(particleId);
+		bool const isBefore = beforeIt != naviBefore.particleIndicesByParticleIds.end();
+		bool const isAfter = afterIt != naviAfter.particleIndicesByParticleIds.end();
+		if (isBefore && isAfter) {
+			ParticleChangeDescription change(dataBefore.particles->at(beforeIt->second), dataAfter.particles->at(afterIt->second));
+			if (!change.isEmpty()) {
+				addModifiedParticle(change);
+			}
+		}
+		else if (isBefore) {
+			auto const& particleBefore = dataBefore.particles->at(beforeIt->second);
+			addDeletedParticle(ParticleChangeDescription().setId(particleBefore.id).setPos(*particleBefore.pos));
+		}
+		else if (isAfter) {
+			newParticles.emplace_back(&dataAfter.particles->at(afterIt->second));
+		}
+	}
+	for (auto const& particle : newParticles) {
+		addNewParticle(ParticleChangeDescription(*particle));
+	}
+}
@@ -115,6 +115,10 @@ struct MODELBASIC_EXPORT DataChangeDescription
 	DataChangeDescription(DataDescription const& desc);
 	DataChangeDescription(DataDescription const& dataBefore, DataDescription const& dataAfter);
 
+	//only edited entities are compared, the navigators are used to find them in the data
+	DataChangeDescription(DataDescription const& dataBefore, DescriptionNavigator const& naviBefore
+		, DataDescription const& dataAfter, DescriptionNavigator const& naviAfter, DescriptionEdits const& edits);
+
 	DataChangeDescription& addNewCluster(ClusterChangeDescription const& value)
 	{
 		clusters.emplace_back(StateTracker<ClusterChangeDescription>(value, StateTracker<ClusterChangeDescription>::State::Added));
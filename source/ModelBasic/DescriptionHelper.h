@@ -11,8 +11,9 @@ public:
 
 	virtual void init(SimulationContext* context) = 0;
 
-	virtual void reconnect(DataDescription& data, DataDescription& orgData, unordered_set<uint64_t> const& idsOfChangedCells) = 0;
-	virtual void recluster(DataDescription& data, unordered_set<uint64_t> const& idsOfChangedClusters) = 0;
+	//both return the ids of the clusters which are replaced and of the new clusters
+	virtual unordered_set<uint64_t> reconnect(DataDescription& data, DataDescription& orgData, unordered_set<uint64_t> const& idsOfChangedCells) = 0;
+	virtual unordered_set<uint64_t> recluster(DataDescription& data, unordered_set<uint64_t> const& idsOfChangedClusters) = 0;
     virtual void makeValid(DataDescription& data) = 0;
     virtual void makeValid(ClusterDescription& cluster) = 0;
 	virtual void makeValid(ParticleDescription& particle) = 0;
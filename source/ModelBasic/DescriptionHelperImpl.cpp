@@ -1,10 +1,12 @@
 #include <algorithm>
 
 #include "Base/NumberGenerator.h"
+#include "Base/Parallel.h"
+#include "Base/UnionFind.h"
 
 #include "DescriptionHelperImpl.h"
 
-#include "SpaceProperties.h"
+#include "TorusMetric.h"
 #include "SimulationParameters.h"
 #include "SimulationContext.h"
 #include "Physics.h"
@@ -12,15 +14,14 @@
 
 void DescriptionHelperImpl::init(SimulationContext* context)
 {
-	_metric = context->getSpaceProperties();
 	_parameters = context->getSimulationParameters();
 	_numberGen = context->getNumberGenerator();
 }
 
-void DescriptionHelperImpl::reconnect(DataDescription &data, DataDescription& orgData, unordered_set<uint64_t> const& idsOfChangedCells)
+unordered_set<uint64_t> DescriptionHelperImpl::reconnect(DataDescription &data, DataDescription& orgData, unordered_set<uint64_t> const& idsOfChangedCells)
 {
 	if (!data.clusters) {
-		return;
+		return {};
 	}
 	_data = &data;
 	_origData = &orgData;
@@ -33,19 +34,19 @@ void DescriptionHelperImpl::reconnect(DataDescription &data, DataDescription& or
 	for (uint64_t cellId : changedAndPresentCellIds) {
 		clusterIds.insert(_navi.clusterIdsByCellIds.at(cellId));
 	}
-	reclustering(clusterIds);
+	return reclustering(clusterIds);
 }
 
-void DescriptionHelperImpl::recluster(DataDescription & data, unordered_set<uint64_t> const & idsOfChangedClusters)
+unordered_set<uint64_t> DescriptionHelperImpl::recluster(DataDescription & data, unordered_set<uint64_t> const & idsOfChangedClusters)
 {
 	if (!data.clusters) {
-		return;
+		return {};
 	}
 	_data = &data;
 	_origData = &data;
 
 	updateInternals();
-	reclustering(idsOfChangedClusters);
+	return reclustering(idsOfChangedClusters);
 }
 
 void DescriptionHelperImpl::makeValid(DataDescription & data)
@@ -90,37 +91,127 @@ void DescriptionHelperImpl::makeValid(ParticleDescription & particle)
 
 void DescriptionHelperImpl::duplicate(DataDescription& data, IntVector2D const& origSize, IntVector2D const& size)
 {
-    DataDescription result;
-
-    for (int incX = 0; incX < size.x; incX += origSize.x) {
-        for (int incY = 0; incY < size.y; incY += origSize.y) {
-            if (data.clusters) {
-                for (auto cluster : *data.clusters) {
-                    auto origPos = *cluster.pos;
-                    cluster.pos = QVector2D{ origPos.x() + incX, origPos.y() + incY };
-                    if (cluster.pos->x() < size.x && cluster.pos->y() < size.y) {
-                        if (cluster.cells) {
-                            for (auto& cell : *cluster.cells) {
-                                auto origPos = *cell.pos;
-                                cell.pos = QVector2D{ origPos.x() + incX, origPos.y() + incY };
-                            }
-                        }
-                        result.addCluster(cluster);
-                    }
-                }
-            }
-            if (data.particles) {
-                for (auto particle : *data.particles) {
-                    auto origPos = *particle.pos;
-                    particle.pos = QVector2D{ origPos.x() + incX, origPos.y() + incY };
-                    if (particle.pos->x() < size.x && particle.pos->y() < size.y) {
-                        result.addParticle(particle);
-                    }
-                }
-            }
-        }
-    }
-    data = result;
+	vector<IntVector2D> tileOffsets;
+	for (int incX = 0; incX < size.x; incX += origSize.x) {
+		for (int incY = 0; incY < size.y; incY += origSize.y) {
+			tileOffsets.push_back({ incX, incY });
+		}
+	}
+	int const numTiles = tileOffsets.size();
+	auto const isInsideUniverse = [&size](QVector2D const& pos, IntVector2D const& tileOffset) {
+		return pos.x() + tileOffset.x < size.x && pos.y() + tileOffset.y < size.y;
+	};
+	auto const shift = [](QVector2D const& pos, IntVector2D const& tileOffset) {
+		return QVector2D{ pos.x() + tileOffset.x, pos.y() + tileOffset.y };
+	};
+
+	DataDescription result;
+	if (data.clusters) {
+		auto const& clusters = *data.clusters;
+		int const numClusters = clusters.size();
+
+		//connections of the original data are converted to cell indices once, copies only add an offset
+		vector<int> cellStartIndices(numClusters + 1, 0);
+		vector<int> connectionStartIndices(1, 0);
+		for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex) {
+			auto const& cells = clusters[clusterIndex].cells;
+			cellStartIndices[clusterIndex + 1] = cellStartIndices[clusterIndex] + (cells ? cells->size() : 0);
+			if (cells) {
+				for (auto const& cell : *cells) {
+					connectionStartIndices.push_back(connectionStartIndices.back() + (cell.connectingCells ? cell.connectingCells->size() : 0));
+				}
+			}
+		}
+		int const numCells = cellStartIndices.back();
+		vector<int> connectingCellIndices(connectionStartIndices.back());
+		executeInParallel(numClusters, [&](int clusterIndex) {
+			auto const& cells = clusters[clusterIndex].cells;
+			if (!cells) {
+				return;
+			}
+			FlatHashMap<uint64_t, int> cellIndicesByIds;
+			cellIndicesByIds.reserve(cells->size());
+			for (int index = 0; index < cells->size(); ++index) {
+				cellIndicesByIds.insert_or_assign(cells->at(index).id, cellStartIndices[clusterIndex] + index);
+			}
+			int connectionIndex = connectionStartIndices[cellStartIndices[clusterIndex]];
+			for (auto const& cell : *cells) {
+				if (cell.connectingCells) {
+					for (uint64_t connectingCellId : *cell.connectingCells) {
+						connectingCellIndices[connectionIndex++] = cellIndicesByIds.at(connectingCellId);
+					}
+				}
+			}
+		}, 4);
+
+		vector<int> targetIndices(numTiles * numClusters, -1);
+		int numTargetClusters = 0;
+		for (int index = 0; index < targetIndices.size(); ++index) {
+			if (isInsideUniverse(*clusters[index % numClusters].pos, tileOffsets[index / numClusters])) {
+				targetIndices[index] = numTargetClusters++;
+			}
+		}
+
+		result.clusters = vector<ClusterDescription>(numTargetClusters);
+		auto& targetClusters = *result.clusters;
+		auto const firstClusterId = _numberGen->getIds(targetIndices.size());
+		auto const firstCellId = _numberGen->getIds(static_cast<uint64_t>(numTiles) * numCells);
+		executeInParallel(targetIndices.size(), [&](int index) {
+			if (targetIndices[index] < 0) {
+				return;
+			}
+			int const tile = index / numClusters;
+			int const clusterIndex = index % numClusters;
+			auto const& tileOffset = tileOffsets[tile];
+			auto const cellIdOffset = firstCellId + static_cast<uint64_t>(tile) * numCells;
+
+			auto& cluster = targetClusters[targetIndices[index]];
+			cluster = clusters[clusterIndex];
+			cluster.id = firstClusterId + index;
+			cluster.pos = shift(*cluster.pos, tileOffset);
+			if (cluster.cells) {
+				int cellIndex = cellStartIndices[clusterIndex];
+				for (auto& cell : *cluster.cells) {
+					cell.id = cellIdOffset + cellIndex;
+					cell.pos = shift(*cell.pos, tileOffset);
+					if (cell.connectingCells) {
+						int connectionIndex = connectionStartIndices[cellIndex];
+						for (uint64_t& connectingCellId : *cell.connectingCells) {
+							connectingCellId = cellIdOffset + connectingCellIndices[connectionIndex++];
+						}
+					}
+					++cellIndex;
+				}
+			}
+		}, 4);
+	}
+
+	if (data.particles) {
+		auto const& particles = *data.particles;
+		int const numParticles = particles.size();
+
+		vector<int> targetIndices(numTiles * numParticles, -1);
+		int numTargetParticles = 0;
+		for (int index = 0; index < targetIndices.size(); ++index) {
+			if (isInsideUniverse(*particles[index % numParticles].pos, tileOffsets[index / numParticles])) {
+				targetIndices[index] = numTargetParticles++;
+			}
+		}
+
+		result.particles = vector<ParticleDescription>(numTargetParticles);
+		auto& targetParticles = *result.particles;
+		auto const firstParticleId = _numberGen->getIds(targetIndices.size());
+		executeInParallel(targetIndices.size(), [&](int index) {
+			if (targetIndices[index] < 0) {
+				return;
+			}
+			auto& particle = targetParticles[targetIndices[index]];
+			particle = particles[index % numParticles];
+			particle.id = firstParticleId + index;
+			particle.pos = shift(*particle.pos, tileOffsets[index / numParticles]);
+		});
+	}
+	data = std::move(result);
 }
 
 list<uint64_t> DescriptionHelperImpl::filterPresentCellIds(unordered_set<uint64_t> const & cellIds) const
@@ -136,15 +227,27 @@ void DescriptionHelperImpl::updateInternals()
 {
 	_navi.update(*_data);
 	_origNavi.update(*_origData);
+	updateCellGrid();
+}
 
-	_cellMap.clear();
+void DescriptionHelperImpl::updateCellGrid()
+{
+	auto const numCells = _navi.cellIds.size();
+	vector<int> posX;
+	vector<int> posY;
+	posX.reserve(numCells);
+	posY.reserve(numCells);
+	_gridCellIds.clear();
+	_gridCellIds.reserve(numCells);
 	for (auto const &cluster : *_data->clusters) {
 		for (auto const &cell : *cluster.cells) {
-			auto const &pos = *cell.pos;
-			auto intPos = _metric->convertToIntVector(pos);
-			_cellMap[intPos.x][intPos.y].push_back(cell.id);
+			auto intPos = TorusMetric::convertToIntVector(*cell.pos);
+			posX.emplace_back(intPos.x);
+			posY.emplace_back(intPos.y);
+			_gridCellIds.emplace_back(cell.id);
 		}
 	}
+	_cellGrid.build(posX, posY, static_cast<int>(std::ceil(_parameters.cellMaxDistance)));
 }
 
 void DescriptionHelperImpl::updateConnectingCells(list<uint64_t> const &changedCellIds)
@@ -160,65 +263,82 @@ void DescriptionHelperImpl::updateConnectingCells(list<uint64_t> const &changedC
 	}
 }
 
-void DescriptionHelperImpl::reclustering(unordered_set<uint64_t> const& clusterIds)
+unordered_set<uint64_t> DescriptionHelperImpl::reclustering(unordered_set<uint64_t> const& clusterIds)
 {
-	unordered_set<uint64_t> affectedClusterIndices;
+	//collect affected clusters and all clusters connected to them
+	vector<int> affectedClusterIndices;
+	unordered_set<int> discardedClusterIndices;
 	for (uint64_t clusterId : clusterIds) {
-		affectedClusterIndices.insert(_navi.clusterIndicesByClusterIds.at(clusterId));
+		int clusterIndex = _navi.clusterIndicesByClusterIds.at(clusterId);
+		if (discardedClusterIndices.insert(clusterIndex).second) {
+			affectedClusterIndices.push_back(clusterIndex);
+		}
 	}
 
-	vector<ClusterDescription> newClusters;
-	unordered_set<uint64_t> remainingCellIds;
-	for (int affectedClusterIndex : affectedClusterIndices) {
-		for (auto &cell : *_data->clusters->at(affectedClusterIndex).cells) {
-			remainingCellIds.insert(cell.id);
+	vector<uint64_t> cellIds;
+	FlatHashMap<uint64_t, int> localIndicesByCellIds;
+	for (int i = 0; i < affectedClusterIndices.size(); ++i) {
+		auto const& cluster = _data->clusters->at(affectedClusterIndices[i]);
+		if (!cluster.cells) {
+			continue;
+		}
+		for (auto const& cell : *cluster.cells) {
+			localIndicesByCellIds.insert_or_assign(cell.id, static_cast<int>(cellIds.size()));
+			cellIds.push_back(cell.id);
+			if (cell.connectingCells) {
+				for (uint64_t connectingCellId : *cell.connectingCells) {
+					int connectingClusterIndex = _navi.clusterIndicesByCellIds.at(connectingCellId);
+					if (discardedClusterIndices.insert(connectingClusterIndex).second) {
+						affectedClusterIndices.push_back(connectingClusterIndex);
+					}
+				}
+			}
 		}
 	}
 
-	unordered_set<uint64_t> lookedUpCellIds;
-
-	while (!remainingCellIds.empty()) {
-		ClusterDescription newCluster;
-		lookUpCell(*remainingCellIds.begin(), newCluster, lookedUpCellIds, remainingCellIds);
-		if (newCluster.cells && !newCluster.cells->empty()) {
-			newCluster.id = _numberGen->getId();
-			setClusterAttributes(newCluster);
-			newClusters.push_back(newCluster);
+	//connected components via union-find, bonds are processed in parallel
+	UnionFind components(cellIds.size());
+	executeInParallel(cellIds.size(), [&](int index) {
+		auto const& cell = getCellDescRef(cellIds[index]);
+		if (!cell.connectingCells) {
+			return;
 		}
-	}
+		for (uint64_t connectingCellId : *cell.connectingCells) {
+			components.unite(index, localIndicesByCellIds.at(connectingCellId));
+		}
+	}, 1024);
 
-	unordered_set<int> discardedClusterIndices;
-	for (uint64_t lookedUpCellId : lookedUpCellIds) {
-		discardedClusterIndices.insert(_navi.clusterIndicesByCellIds.at(lookedUpCellId));
+	vector<int> componentIndices;
+	auto const numComponents = components.getComponentIndices(componentIndices);
+	vector<ClusterDescription> newClusters(numComponents);
+	for (auto& newCluster : newClusters) {
+		newCluster.id = _numberGen->getId();
+		newCluster.cells = vector<CellDescription>();
 	}
+	for (int index = 0; index < cellIds.size(); ++index) {
+		newClusters[componentIndices[index]].cells->push_back(getCellDescRef(cellIds[index]));
+	}
+
+	//attributes of the new clusters only depend on the original data
+	executeInParallel(newClusters.size(), [&](int index) {
+		setClusterAttributes(newClusters[index]);
+	});
 
+	unordered_set<uint64_t> result;
+	for (auto const& newCluster : newClusters) {
+		result.insert(newCluster.id);
+	}
 	for (int clusterIndex = 0; clusterIndex < _data->clusters->size(); ++clusterIndex) {
 		if (discardedClusterIndices.find(clusterIndex) == discardedClusterIndices.end()) {
 			newClusters.emplace_back(_data->clusters->at(clusterIndex));
 		}
+		else {
+			result.insert(_data->clusters->at(clusterIndex).id);
+		}
 	}
 
 	_data->clusters = newClusters;
-}
-
-void DescriptionHelperImpl::lookUpCell(uint64_t cellId, ClusterDescription &newCluster, unordered_set<uint64_t> &lookedUpCellIds
-	, unordered_set<uint64_t> &remainingCellIds)
-{
-	if (lookedUpCellIds.find(cellId) != lookedUpCellIds.end()) {
-		return;
-	}
-	
-	lookedUpCellIds.insert(cellId);
-	remainingCellIds.erase(cellId);
-
-	auto &cell = getCellDescRef(cellId);
-	newCluster.addCell(cell);
-
-	if (cell.connectingCells) {
-		for (uint64_t connectingCellId : *cell.connectingCells) {
-			lookUpCell(connectingCellId, newCluster, lookedUpCellIds, remainingCellIds);
-		}
-	}
+	return result;
 }
 
 CellDescription & DescriptionHelperImpl::getCellDescRef(uint64_t cellId)
@@ -246,14 +366,10 @@ void DescriptionHelperImpl::establishNewConnectionsWithNeighborCells(CellDescrip
 {
 	int r = static_cast<int>(std::ceil(_parameters.cellMaxDistance));
 	IntVector2D pos = *cellDesc.pos;
-	for(int dx = -r; dx <= r; ++dx) {
-		for (int dy = -r; dy <= r; ++dy) {
-			IntVector2D scanPos = { pos.x + dx, pos.y + dy };
-			auto cellIds = getCellIdsAtPos(scanPos);
-			for (uint64_t cellId : cellIds) {
-				establishNewConnection(cellDesc, getCellDescRef(cellId));
-			}
-		}
+	vector<uint64_t> cellIds;
+	getCellIdsInRange(pos, r, cellIds);
+	for (uint64_t cellId : cellIds) {
+		establishNewConnection(cellDesc, getCellDescRef(cellId));
 	}
 }
 
@@ -291,41 +407,47 @@ double DescriptionHelperImpl::getDistance(CellDescription &cell1, CellDescriptio
 	return displacement.length();
 }
 
-list<uint64_t> DescriptionHelperImpl::getCellIdsAtPos(IntVector2D const &pos)
+void DescriptionHelperImpl::getCellIdsInRange(IntVector2D const &pos, int radius, vector<uint64_t>& result)
 {
-	auto xIter = _cellMap.find(pos.x);
-	if (xIter != _cellMap.end()) {
-		unordered_map<int, list<uint64_t>> &mapRemainder = xIter->second;
-		auto yIter = mapRemainder.find(pos.y);
-		if (yIter != mapRemainder.end()) {
-			return yIter->second;
-		}
-	}
-	return list<uint64_t>();
-}
+	result.clear();
+	_gridCandidates.clear();
+	_cellGrid.forEachInRange(pos, radius, [this](int index, int x, int y) {
+		_gridCandidates.push_back({ { x, y }, index, _gridCellIds[index] });
+	});
 
-namespace
-{
-	QVector2D calcCenter(vector<CellDescription> const & cells)
-	{
-		QVector2D result;
-		for (auto const& cell : cells) {
-			result += *cell.pos;
+	//scan order by position as for a cell-by-cell scan => connections are established deterministically
+	std::sort(_gridCandidates.begin(), _gridCandidates.end(), [](GridEntry const& entry1, GridEntry const& entry2) {
+		if (entry1.pos.x != entry2.pos.x) {
+			return entry1.pos.x < entry2.pos.x;
 		}
-		result = result / cells.size();
-		return result;
+		if (entry1.pos.y != entry2.pos.y) {
+			return entry1.pos.y < entry2.pos.y;
+		}
+		return entry1.order < entry2.order;
+	});
+	for (auto const& entry : _gridCandidates) {
+		result.push_back(entry.cellId);
 	}
 }
 
 void DescriptionHelperImpl::setClusterAttributes(ClusterDescription& cluster)
 {
-	cluster.pos = calcCenter(*cluster.cells);
-	cluster.angle = calcAngleBasedOnOrigClusters(*cluster.cells);
-	auto velocities = calcVelocitiesBasedOnOrigClusters(*cluster.cells);
-	double v = velocities.linear.length();
+	auto const& cells = *cluster.cells;
+	int const numCells = cells.size();
+	vector<double> posX(numCells);
+	vector<double> posY(numCells);
+	for (int index = 0; index < numCells; ++index) {
+		posX[index] = cells[index].pos->x();
+		posY[index] = cells[index].pos->y();
+	}
+	auto const center = Physics::centerOfMass(posX.data(), posY.data(), numCells);
+
+	cluster.pos = center;
+	cluster.angle = calcAngleBasedOnOrigClusters(cells);
+	auto velocities = calcVelocitiesBasedOnOrigClusters(cells, posX, posY, center);
 	cluster.vel = velocities.linear;
 	cluster.angularVel = velocities.angular;
-	if (auto clusterMetadata = calcMetadataBasedOnOrigClusters(*cluster.cells)) {
+	if (auto clusterMetadata = calcMetadataBasedOnOrigClusters(cells)) {
 		cluster.metadata = *clusterMetadata;
 	}
 }
@@ -341,62 +463,36 @@ double DescriptionHelperImpl::calcAngleBasedOnOrigClusters(vector<CellDescriptio
 	return result;
 }
 
-namespace
-{
-	double calcAngularMass(vector<CellDescription> const & cells)
-	{
-		QVector2D center = calcCenter(cells);
-		double result = 0.0;
-		for (auto const& cell : cells) {
-			result += (*cell.pos - center).lengthSquared();
-		}
-		return result;
-	}
-}
-
-Physics::Velocities DescriptionHelperImpl::calcVelocitiesBasedOnOrigClusters(vector<CellDescription> const & cells) const
+Physics::Velocities DescriptionHelperImpl::calcVelocitiesBasedOnOrigClusters(vector<CellDescription> const & cells
+	, vector<double> const& posX, vector<double> const& posY, QVector2D const& center) const
 {
 	CHECK(!cells.empty());
 	
 	Physics::Velocities result{ QVector2D(), 0.0 };
-	if (cells.size() == 1) {
-		auto cell = cells.front();
-		if (_origNavi.clusterIndicesByCellIds.find(cell.id) == _origNavi.clusterIndicesByCellIds.end()
-			|| _origNavi.cellIndicesByCellIds.find(cell.id) == _origNavi.cellIndicesByCellIds.end()) {
+	int const numCells = cells.size();
+	vector<double> velX(numCells);
+	vector<double> velY(numCells);
+	for (int index = 0; index < numCells; ++index) {
+		auto const& cell = cells[index];
+		auto clusterIndexIt = _origNavi.clusterIndicesByCellIds.find(cell.id);
+		auto cellIndexIt = _origNavi.cellIndicesByCellIds.find(cell.id);
+		if (clusterIndexIt == _origNavi.clusterIndicesByCellIds.end() || cellIndexIt == _origNavi.cellIndicesByCellIds.end()) {
 			return result;
 		}
-		int clusterIndex = _origNavi.clusterIndicesByCellIds.at(cell.id);
-		int cellIndex = _origNavi.cellIndicesByCellIds.at(cell.id);
-		auto const& origCluster = _origData->clusters->at(clusterIndex);
-		auto const& origCell = origCluster.cells->at(cellIndex);
-		result.linear= Physics::tangentialVelocity(*origCell.pos - *origCluster.pos, { *origCluster.vel, *origCluster.angularVel });
+		auto const& origCluster = _origData->clusters->at(clusterIndexIt->second);
+		auto const& origCell = origCluster.cells->at(cellIndexIt->second);
+		auto const cellVel = Physics::tangentialVelocity(*origCell.pos - *origCluster.pos, { *origCluster.vel, *origCluster.angularVel });
+		velX[index] = cellVel.x();
+		velY[index] = cellVel.y();
+	}
+	result.linear = Physics::centerOfMass(velX.data(), velY.data(), numCells);
+	if (1 == numCells) {
 		return result;
 	}
 
-	unordered_map<uint64_t, QVector2D> cellVel;
-	for (auto const& cell : cells) {
-		if (_origNavi.clusterIndicesByCellIds.find(cell.id) == _origNavi.clusterIndicesByCellIds.end()
-			|| _origNavi.cellIndicesByCellIds.find(cell.id) == _origNavi.cellIndicesByCellIds.end()) {
-			return result;
-		}
-		int clusterIndex = _origNavi.clusterIndicesByCellIds.at(cell.id);
-		int cellIndex = _origNavi.cellIndicesByCellIds.at(cell.id);
-		auto const& origCluster = _origData->clusters->at(clusterIndex);
-		auto const& origCell = origCluster.cells->at(cellIndex);
-		cellVel.insert_or_assign(cell.id, Physics::tangentialVelocity(*origCell.pos - *origCluster.pos, { *origCluster.vel, *origCluster.angularVel }));
-		result.linear += cellVel.at(cell.id);
-	}
-	result.linear /= cells.size();
-
-	QVector2D center = calcCenter(cells);
-	double angularMomentum = 0.0;
-	for (auto const& cell : cells) {
-		QVector2D r = *cell.pos - center;
-		QVector2D v = cellVel.at(cell.id) - result.linear;
-		angularMomentum += Physics::angularMomentum(r, v);
-	}
-	result.angular = Physics::angularVelocity(angularMomentum, calcAngularMass(cells));
-
+	auto const angularMomentum = Physics::angularMomentum(posX.data(), posY.data(), velX.data(), velY.data(), numCells, center, result.linear);
+	auto const angularMass = Physics::angularMass(posX.data(), posY.data(), numCells, center);
+	result.angular = Physics::angularVelocity(angularMomentum, angularMass);
 	return result;
 }
 
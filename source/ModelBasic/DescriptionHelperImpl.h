@@ -2,6 +2,7 @@
 
 #include "DescriptionHelper.h"
 #include "ModelBasic/Physics.h"
+#include "ModelBasic/SpatialGrid.h"
 
 class DescriptionHelperImpl
 	: public DescriptionHelper
@@ -13,8 +14,8 @@ public:
 
 	virtual void init(SimulationContext* context) override;
 
-	virtual void reconnect(DataDescription& data, DataDescription& orgData, unordered_set<uint64_t> const& idsOfChangedCells) override;
-	virtual void recluster(DataDescription& data, unordered_set<uint64_t> const& idsOfChangedClusters) override;
+	virtual unordered_set<uint64_t> reconnect(DataDescription& data, DataDescription& orgData, unordered_set<uint64_t> const& idsOfChangedCells) override;
+	virtual unordered_set<uint64_t> recluster(DataDescription& data, unordered_set<uint64_t> const& idsOfChangedClusters) override;
     virtual void makeValid(DataDescription& data) override;
     virtual void makeValid(ClusterDescription& cluster) override;
 	virtual void makeValid(ParticleDescription& particle) override;
@@ -25,7 +26,7 @@ private:
 	list<uint64_t> filterPresentCellIds(unordered_set<uint64_t> const& cellIds) const;
 	void updateInternals();
 	void updateConnectingCells(list<uint64_t> const &changedCellIds);
-	void reclustering(unordered_set<uint64_t> const& clusterIds);
+	unordered_set<uint64_t> reclustering(unordered_set<uint64_t> const& clusterIds);
 
 	CellDescription& getCellDescRef(uint64_t cellId);
 	void removeConnections(CellDescription &cellDesc);
@@ -33,17 +34,15 @@ private:
 	void establishNewConnection(CellDescription &cell1, CellDescription &cell2) const;
 	double getDistance(CellDescription &cell1, CellDescription &cell2) const;
 
-	list<uint64_t> getCellIdsAtPos(IntVector2D const &pos);
-
-	unordered_set<int> reclusteringSingleClusterAndReturnDiscardedClusterIndices(int clusterIndex, vector<ClusterDescription> &newClusters);
-	void lookUpCell(uint64_t cellId, ClusterDescription &newCluster, unordered_set<uint64_t> &lookedUpCellIds, unordered_set<uint64_t> &remainingCellIds);
+	void updateCellGrid();
+	void getCellIdsInRange(IntVector2D const &pos, int radius, vector<uint64_t>& result);
 
 	void setClusterAttributes(ClusterDescription& cluster);
 	double calcAngleBasedOnOrigClusters(vector<CellDescription> const & cells) const;
-	Physics::Velocities calcVelocitiesBasedOnOrigClusters(vector<CellDescription> const & cells) const;
+	Physics::Velocities calcVelocitiesBasedOnOrigClusters(vector<CellDescription> const & cells
+		, vector<double> const& posX, vector<double> const& posY, QVector2D const& center) const;
 	optional<ClusterMetadata> calcMetadataBasedOnOrigClusters(vector<CellDescription> const & cells) const;
 
-	SpaceProperties* _metric = nullptr;
 	SimulationParameters _parameters;
 	NumberGenerator* _numberGen = nullptr;
 
@@ -51,5 +50,15 @@ private:
 	DataDescription* _origData = nullptr;
 	DescriptionNavigator _navi;
 	DescriptionNavigator _origNavi;
-	unordered_map<int, unordered_map<int, list<uint64_t>>> _cellMap;
+
+	//grid over the cells, point index i refers to _gridCellIds[i]
+	SpatialGrid _cellGrid;
+	vector<uint64_t> _gridCellIds;
+	struct GridEntry
+	{
+		IntVector2D pos;
+		int order;
+		uint64_t cellId;
+	};
+	vector<GridEntry> _gridCandidates;
 };
@@ -1,14 +1,168 @@
+#include <type_traits>
 #include <QMatrix4x4>
 
 #include "Descriptions.h"
 #include "ChangeDescriptions.h"
 
+namespace
+{
+	//64 bit FNV-1a
+	class HashBuilder
+	{
+	public:
+		void addBytes(void const* data, size_t size)
+		{
+			auto bytes = static_cast<unsigned char const*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				_hash = (_hash ^ bytes[i]) * 1099511628211ULL;
+			}
+		}
+
+		template<typename T>
+		void add(T const& value)
+		{
+			static_assert(std::is_arithmetic<T>::value, "unsupported type");
+			addBytes(&value, sizeof(T));
+		}
+
+		template<typename T>
+		void add(optional<T> const& value)
+		{
+			add(static_cast<bool>(value));
+			if (value) {
+				add(*value);
+			}
+		}
+
+		template<typename T>
+		void add(list<T> const& values)
+		{
+			add(values.size());
+			for (auto const& value : values) {
+				add(value);
+			}
+		}
+
+		template<typename T>
+		void add(vector<T> const& values)
+		{
+			add(values.size());
+			for (auto const& value : values) {
+				add(value);
+			}
+		}
+
+		void add(QVector2D const& value)
+		{
+			add(value.x());
+			add(value.y());
+		}
+
+		void add(QByteArray const& value)
+		{
+			add(value.size());
+			addBytes(value.constData(), value.size());
+		}
+
+		void add(QString const& value)
+		{
+			add(value.size());
+			addBytes(value.constData(), value.size() * sizeof(QChar));
+		}
+
+		void add(TokenDescription const& value)
+		{
+			add(value.energy);
+			add(value.data);
+		}
+
+		void add(CellMetadata const& value)
+		{
+			add(value.computerSourcecode);
+			add(value.name);
+			add(value.description);
+			add(value.color);
+		}
+
+		void add(CellFeatureDescription const& value)
+		{
+			add(static_cast<int>(value.getType()));
+			add(value.volatileData);
+			add(value.constData);
+		}
+
+		void add(ClusterMetadata const& value)
+		{
+			add(value.name);
+		}
+
+		void add(ParticleMetadata const& value)
+		{
+			add(value.color);
+		}
+
+		uint64_t getHash() const
+		{
+			return _hash;
+		}
+
+	private:
+		uint64_t _hash = 14695981039346656037ULL;
+	};
+}
+
 
 bool TokenDescription::operator==(TokenDescription const& other) const {
 	return energy == other.energy
 		&& data == other.data;
 }
 
+uint64_t CellDescription::getHash() const
+{
+	HashBuilder builder;
+	builder.add(id);
+	builder.add(pos);
+	builder.add(energy);
+	builder.add(maxConnections);
+	builder.add(connectingCells);
+	builder.add(tokenBlocked);
+	builder.add(tokenBranchNumber);
+	builder.add(metadata);
+	builder.add(cellFeature);
+	builder.add(tokens);
+	builder.add(tokenUsages);
+	return builder.getHash();
+}
+
+uint64_t ClusterDescription::getHash() const
+{
+	HashBuilder builder;
+	builder.add(id);
+	builder.add(pos);
+	builder.add(vel);
+	builder.add(angle);
+	builder.add(angularVel);
+	builder.add(metadata);
+	builder.add(static_cast<bool>(cells));
+	if (cells) {
+		for (auto const& cell : *cells) {
+			builder.add(cell.getHash());
+		}
+	}
+	return builder.getHash();
+}
+
+uint64_t ParticleDescription::getHash() const
+{
+	HashBuilder builder;
+	builder.add(id);
+	builder.add(pos);
+	builder.add(vel);
+	builder.add(energy);
+	builder.add(metadata);
+	return builder.getHash();
+}
+
 CellDescription::CellDescription(CellChangeDescription const & change)
 {
 	id = change.id;
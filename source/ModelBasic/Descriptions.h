@@ -1,4 +1,6 @@
 #pragma once
+#include "Base/FlatHashMap.h"
+
 #include "Definitions.h"
 #include "Metadata.h"
 
@@ -71,6 +73,7 @@ struct MODELBASIC_EXPORT CellDescription
     CellDescription& setTokenUsages(int value) { tokenUsages = value; return *this; }
     QVector2D getPosRelativeTo(ClusterDescription const& cluster) const;
     bool isConnectedTo(uint64_t id) const;
+	uint64_t getHash() const;	//content hash, equal descriptions have equal hashes
 };
 
 struct MODELBASIC_EXPORT ClusterDescription
@@ -110,6 +113,7 @@ struct MODELBASIC_EXPORT ClusterDescription
 	}
 
 	QVector2D getClusterPosFromCells() const;
+	uint64_t getHash() const;
 };
 
 struct MODELBASIC_EXPORT ParticleDescription
@@ -128,6 +132,7 @@ struct MODELBASIC_EXPORT ParticleDescription
 	ParticleDescription& setVel(QVector2D const& value) { vel = value; return *this; }
 	ParticleDescription& setEnergy(double value) { energy = value; return *this; }
     ParticleDescription& setMetadata(ParticleMetadata const& value) { metadata = value; return *this; }
+	uint64_t getHash() const;
 };
 
 struct MODELBASIC_EXPORT DataDescription
@@ -186,13 +191,13 @@ struct ResolveDescription
 
 struct DescriptionNavigator
 {
-	unordered_set<uint64_t> cellIds;
-	unordered_set<uint64_t> particleIds;
-	map<uint64_t, uint64_t> clusterIdsByCellIds;
-	map<uint64_t, int> clusterIndicesByClusterIds;
-	map<uint64_t, int> clusterIndicesByCellIds;
-	map<uint64_t, int> cellIndicesByCellIds;
-	map<uint64_t, int> particleIndicesByParticleIds;
+	FlatHashSet<uint64_t> cellIds;
+	FlatHashSet<uint64_t> particleIds;
+	FlatHashMap<uint64_t, uint64_t> clusterIdsByCellIds;
+	FlatHashMap<uint64_t, int> clusterIndicesByClusterIds;
+	FlatHashMap<uint64_t, int> clusterIndicesByCellIds;
+	FlatHashMap<uint64_t, int> cellIndicesByCellIds;
+	FlatHashMap<uint64_t, int> particleIndicesByParticleIds;
 
 	void update(DataDescription const& data)
 	{
@@ -206,29 +211,83 @@ struct DescriptionNavigator
 
 		int clusterIndex = 0;
 		if (data.clusters) {
+			int numCells = 0;
 			for (auto const &cluster : *data.clusters) {
-				clusterIndicesByClusterIds.insert_or_assign(cluster.id, clusterIndex);
-				int cellIndex = 0;
-				if (cluster.cells) {
-					for (auto const &cell : *cluster.cells) {
-						clusterIdsByCellIds.insert_or_assign(cell.id, cluster.id);
-						clusterIndicesByCellIds.insert_or_assign(cell.id, clusterIndex);
-						cellIndicesByCellIds.insert_or_assign(cell.id, cellIndex);
-						cellIds.insert(cell.id);
-						++cellIndex;
-					}
-				}
+				numCells += cluster.cells ? cluster.cells->size() : 0;
+			}
+			cellIds.reserve(numCells);
+			clusterIdsByCellIds.reserve(numCells);
+			clusterIndicesByCellIds.reserve(numCells);
+			cellIndicesByCellIds.reserve(numCells);
+			clusterIndicesByClusterIds.reserve(data.clusters->size());
+
+			for (auto const &cluster : *data.clusters) {
+				addCluster(cluster, clusterIndex);
 				++clusterIndex;
 			}
 		}
 
 		int particleIndex = 0;
 		if (data.particles) {
+			particleIds.reserve(data.particles->size());
+			particleIndicesByParticleIds.reserve(data.particles->size());
 			for (auto const &particle : *data.particles) {
-				particleIndicesByParticleIds.insert_or_assign(particle.id, particleIndex);
-				particleIds.insert(particle.id);
+				addParticle(particle, particleIndex);
 				++particleIndex;
 			}
 		}
 	}
+
+	//incremental updates: (re-)registers an entity at the given index or unregisters it
+	void addCluster(ClusterDescription const& cluster, int clusterIndex)
+	{
+		clusterIndicesByClusterIds.insert_or_assign(cluster.id, clusterIndex);
+		int cellIndex = 0;
+		if (cluster.cells) {
+			for (auto const &cell : *cluster.cells) {
+				clusterIdsByCellIds.insert_or_assign(cell.id, cluster.id);
+				clusterIndicesByCellIds.insert_or_assign(cell.id, clusterIndex);
+				cellIndicesByCellIds.insert_or_assign(cell.id, cellIndex);
+				cellIds.insert(cell.id);
+				++cellIndex;
+			}
+		}
+	}
+
+	void removeCluster(ClusterDescription const& cluster)
+	{
+		clusterIndicesByClusterIds.erase(cluster.id);
+		if (cluster.cells) {
+			for (auto const &cell : *cluster.cells) {
+				clusterIdsByCellIds.erase(cell.id);
+				clusterIndicesByCellIds.erase(cell.id);
+				cellIndicesByCellIds.erase(cell.id);
+				cellIds.erase(cell.id);
+			}
+		}
+	}
+
+	void addParticle(ParticleDescription const& particle, int particleIndex)
+	{
+		particleIndicesByParticleIds.insert_or_assign(particle.id, particleIndex);
+		particleIds.insert(particle.id);
+	}
+
+	void removeParticle(ParticleDescription const& particle)
+	{
+		particleIndicesByParticleIds.erase(particle.id);
+		particleIds.erase(particle.id);
+	}
+};
+
+//ids of entities which may have been modified, added or deleted since the last comparison, all other entities are unchanged
+struct DescriptionEdits
+{
+	unordered_set<uint64_t> clusterIds;
+	unordered_set<uint64_t> particleIds;
+	bool all = false;	//unknown edits, e.g. after direct access to the whole data
+
+	void markClusterEdited(uint64_t id) { clusterIds.insert(id); }
+	void markParticleEdited(uint64_t id) { particleIds.insert(id); }
+	void markAllEdited() { all = true; }
 };
@@ -0,0 +1,416 @@
+#include <cstring>
+
+#include "Base/Parallel.h"
+
+#include "PackedDescriptions.h"
+
+namespace
+{
+	size_t const ArenaAlignment = 8;
+	size_t const AllocationOverhead = 16;	//typical bookkeeping of the heap per allocation
+
+	size_t getHeapUsage(QByteArray const& value)
+	{
+		return value.isNull() ? 0 : sizeof(QByteArrayData) + value.capacity() + 1 + AllocationOverhead;
+	}
+
+	size_t getHeapUsage(QString const& value)
+	{
+		return value.isNull() ? 0 : sizeof(QStringData) + (value.capacity() + 1) * sizeof(QChar) + AllocationOverhead;
+	}
+
+	template<typename T>
+	size_t getHeapUsage(vector<T> const& value)
+	{
+		return value.capacity() > 0 ? value.capacity() * sizeof(T) + AllocationOverhead : 0;
+	}
+
+	template<typename T>
+	size_t getHeapUsage(list<T> const& value)
+	{
+		return value.size() * (sizeof(T) + 2 * sizeof(void*) + AllocationOverhead);
+	}
+}
+
+PackedDataDescription::PackedDataDescription(DataDescription const & data)
+{
+	_hasClusters = static_cast<bool>(data.clusters);
+	_hasParticles = static_cast<bool>(data.particles);
+
+	if (data.clusters) {
+		int numCells = 0;
+		for (auto const& cluster : *data.clusters) {
+			numCells += cluster.cells ? cluster.cells->size() : 0;
+		}
+		_clusters.reserve(data.clusters->size());
+		_cells.reserve(numCells);
+
+		for (auto const& cluster : *data.clusters) {
+			PackedCluster packedCluster;
+			packedCluster.id = cluster.id;
+			if (cluster.pos) {
+				packedCluster.pos = *cluster.pos;
+				packedCluster.flags |= PackedCluster::HasPos;
+			}
+			if (cluster.vel) {
+				packedCluster.vel = *cluster.vel;
+				packedCluster.flags |= PackedCluster::HasVel;
+			}
+			if (cluster.angle) {
+				packedCluster.angle = *cluster.angle;
+				packedCluster.flags |= PackedCluster::HasAngle;
+			}
+			if (cluster.angularVel) {
+				packedCluster.angularVel = *cluster.angularVel;
+				packedCluster.flags |= PackedCluster::HasAngularVel;
+			}
+			if (cluster.metadata) {
+				packedCluster.name = addString(cluster.metadata->name);
+				packedCluster.flags |= PackedCluster::HasMetadata;
+			}
+			packedCluster.cellStartIndex = _cells.size();
+			if (cluster.cells) {
+				packedCluster.flags |= PackedCluster::HasCells;
+				for (auto const& cell : *cluster.cells) {
+					addCell(cell);
+				}
+			}
+			packedCluster.numCells = _cells.size() - packedCluster.cellStartIndex;
+			_clusters.emplace_back(packedCluster);
+		}
+	}
+
+	if (data.particles) {
+		_particles.reserve(data.particles->size());
+		for (auto const& particle : *data.particles) {
+			PackedParticle packedParticle;
+			packedParticle.id = particle.id;
+			if (particle.pos) {
+				packedParticle.pos = *particle.pos;
+				packedParticle.flags |= PackedParticle::HasPos;
+			}
+			if (particle.vel) {
+				packedParticle.vel = *particle.vel;
+				packedParticle.flags |= PackedParticle::HasVel;
+			}
+			if (particle.energy) {
+				packedParticle.energy = *particle.energy;
+				packedParticle.flags |= PackedParticle::HasEnergy;
+			}
+			if (particle.metadata) {
+				packedParticle.color = particle.metadata->color;
+				packedParticle.flags |= PackedParticle::HasMetadata;
+			}
+			_particles.emplace_back(packedParticle);
+		}
+	}
+
+	_arena.shrink_to_fit();
+	_tokens.shrink_to_fit();
+}
+
+DataDescription PackedDataDescription::unpack() const
+{
+	DataDescription result;
+	if (_hasClusters) {
+		result.clusters = vector<ClusterDescription>(_clusters.size());
+		auto& clusters = *result.clusters;
+		executeInParallel(_clusters.size(), [&](int index) {
+			clusters[index] = unpackCluster(index);
+		});
+	}
+	if (_hasParticles) {
+		result.particles = vector<ParticleDescription>();
+		result.particles->reserve(_particles.size());
+		for (int index = 0; index < _particles.size(); ++index) {
+			result.particles->emplace_back(unpackParticle(index));
+		}
+	}
+	return result;
+}
+
+ClusterDescription PackedDataDescription::unpackCluster(int clusterIndex) const
+{
+	auto const& packedCluster = _clusters.at(clusterIndex);
+	ClusterDescription result;
+	result.id = packedCluster.id;
+	if (packedCluster.flags & PackedCluster::HasPos) {
+		result.pos = packedCluster.pos;
+	}
+	if (packedCluster.flags & PackedCluster::HasVel) {
+		result.vel = packedCluster.vel;
+	}
+	if (packedCluster.flags & PackedCluster::HasAngle) {
+		result.angle = packedCluster.angle;
+	}
+	if (packedCluster.flags & PackedCluster::HasAngularVel) {
+		result.angularVel = packedCluster.angularVel;
+	}
+	if (packedCluster.flags & PackedCluster::HasMetadata) {
+		result.metadata = ClusterMetadata().setName(getString(packedCluster.name));
+	}
+	if (packedCluster.flags & PackedCluster::HasCells) {
+		result.cells = vector<CellDescription>();
+		result.cells->reserve(packedCluster.numCells);
+		for (int index = 0; index < packedCluster.numCells; ++index) {
+			result.cells->emplace_back(unpackCell(_cells[packedCluster.cellStartIndex + index]));
+		}
+	}
+	return result;
+}
+
+ParticleDescription PackedDataDescription::unpackParticle(int particleIndex) const
+{
+	auto const& packedParticle = _particles.at(particleIndex);
+	ParticleDescription result;
+	result.id = packedParticle.id;
+	if (packedParticle.flags & PackedParticle::HasPos) {
+		result.pos = packedParticle.pos;
+	}
+	if (packedParticle.flags & PackedParticle::HasVel) {
+		result.vel = packedParticle.vel;
+	}
+	if (packedParticle.flags & PackedParticle::HasEnergy) {
+		result.energy = packedParticle.energy;
+	}
+	if (packedParticle.flags & PackedParticle::HasMetadata) {
+		result.metadata = ParticleMetadata().setColor(packedParticle.color);
+	}
+	return result;
+}
+
+size_t PackedDataDescription::getMemoryUsage() const
+{
+	return getHeapUsage(_clusters) + getHeapUsage(_cells) + getHeapUsage(_tokens) + getHeapUsage(_particles)
+		+ getHeapUsage(_arena);
+}
+
+size_t PackedDataDescription::estimateMemoryUsage(DataDescription const & data)
+{
+	size_t result = 0;
+	if (data.clusters) {
+		result += getHeapUsage(*data.clusters);
+		for (auto const& cluster : *data.clusters) {
+			if (cluster.metadata) {
+				result += getHeapUsage(cluster.metadata->name);
+			}
+			if (!cluster.cells) {
+				continue;
+			}
+			result += getHeapUsage(*cluster.cells);
+			for (auto const& cell : *cluster.cells) {
+				if (cell.connectingCells) {
+					result += getHeapUsage(*cell.connectingCells);
+				}
+				if (cell.metadata) {
+					result += getHeapUsage(cell.metadata->computerSourcecode) + getHeapUsage(cell.metadata->name)
+						+ getHeapUsage(cell.metadata->description);
+				}
+				if (cell.cellFeature) {
+					result += getHeapUsage(cell.cellFeature->volatileData) + getHeapUsage(cell.cellFeature->constData);
+				}
+				if (cell.tokens) {
+					result += getHeapUsage(*cell.tokens);
+					for (auto const& token : *cell.tokens) {
+						if (token.data) {
+							result += getHeapUsage(*token.data);
+						}
+					}
+				}
+			}
+		}
+	}
+	if (data.particles) {
+		result += getHeapUsage(*data.particles);
+	}
+	return result;
+}
+
+PackedBytes PackedDataDescription::addBytes(void const * data, size_t size)
+{
+	PackedBytes result;
+	if (0 == size) {
+		return result;
+	}
+	auto const offset = (_arena.size() + ArenaAlignment - 1) / ArenaAlignment * ArenaAlignment;
+	_arena.resize(offset + size);
+	std::memcpy(&_arena[offset], data, size);
+	result.offset = static_cast<uint32_t>(offset);
+	result.size = static_cast<uint32_t>(size);
+	return result;
+}
+
+PackedBytes PackedDataDescription::addByteArray(QByteArray const & value)
+{
+	return addBytes(value.constData(), value.size());
+}
+
+PackedBytes PackedDataDescription::addString(QString const & value)
+{
+	return addBytes(value.constData(), value.size() * sizeof(QChar));
+}
+
+QByteArray PackedDataDescription::getByteArray(PackedBytes const & bytes) const
+{
+	if (0 == bytes.size) {
+		return QByteArray();
+	}
+	return QByteArray(&_arena[bytes.offset], bytes.size);
+}
+
+QString PackedDataDescription::getString(PackedBytes const & bytes) const
+{
+	if (0 == bytes.size) {
+		return QString();
+	}
+	return QString(reinterpret_cast<QChar const*>(&_arena[bytes.offset]), bytes.size / sizeof(QChar));
+}
+
+void PackedDataDescription::addCell(CellDescription const & cell)
+{
+	PackedCell packedCell;
+	packedCell.id = cell.id;
+	if (cell.pos) {
+		packedCell.pos = *cell.pos;
+		packedCell.flags |= PackedCell::HasPos;
+	}
+	if (cell.energy) {
+		packedCell.energy = *cell.energy;
+		packedCell.flags |= PackedCell::HasEnergy;
+	}
+	if (cell.maxConnections) {
+		packedCell.maxConnections = *cell.maxConnections;
+		packedCell.flags |= PackedCell::HasMaxConnections;
+	}
+	if (cell.connectingCells) {
+		packedCell.flags |= PackedCell::HasConnectingCells;
+		packedCell.numConnections = cell.connectingCells->size();
+		vector<uint64_t> spilledConnections;
+		int index = 0;
+		for (uint64_t connectingCell : *cell.connectingCells) {
+			if (index < PackedCell::NumInlineConnections) {
+				packedCell.connections[index] = connectingCell;
+			}
+			else {
+				spilledConnections.emplace_back(connectingCell);
+			}
+			++index;
+		}
+		packedCell.spilledConnections = addBytes(spilledConnections.data(), spilledConnections.size() * sizeof(uint64_t));
+	}
+	if (cell.tokenBlocked) {
+		packedCell.flags |= PackedCell::HasTokenBlocked;
+		if (*cell.tokenBlocked) {
+			packedCell.flags |= PackedCell::TokenBlocked;
+		}
+	}
+	if (cell.tokenBranchNumber) {
+		packedCell.tokenBranchNumber = *cell.tokenBranchNumber;
+		packedCell.flags |= PackedCell::HasTokenBranchNumber;
+	}
+	if (cell.metadata) {
+		packedCell.computerSourcecode = addString(cell.metadata->computerSourcecode);
+		packedCell.name = addString(cell.metadata->name);
+		packedCell.description = addString(cell.metadata->description);
+		packedCell.color = cell.metadata->color;
+		packedCell.flags |= PackedCell::HasMetadata;
+	}
+	if (cell.cellFeature) {
+		packedCell.featureType = static_cast<uint8_t>(cell.cellFeature->getType());
+		packedCell.volatileData = addByteArray(cell.cellFeature->volatileData);
+		packedCell.constData = addByteArray(cell.cellFeature->constData);
+		packedCell.flags |= PackedCell::HasCellFeature;
+	}
+	packedCell.tokenStartIndex = _tokens.size();
+	if (cell.tokens) {
+		packedCell.flags |= PackedCell::HasTokens;
+		packedCell.numTokens = cell.tokens->size();
+		for (auto const& token : *cell.tokens) {
+			PackedToken packedToken;
+			if (token.energy) {
+				packedToken.energy = *token.energy;
+				packedToken.flags |= PackedToken::HasEnergy;
+			}
+			if (token.data) {
+				packedToken.data = addByteArray(*token.data);
+				packedToken.flags |= PackedToken::HasData;
+			}
+			_tokens.emplace_back(packedToken);
+		}
+	}
+	if (cell.tokenUsages) {
+		packedCell.tokenUsages = *cell.tokenUsages;
+		packedCell.flags |= PackedCell::HasTokenUsages;
+	}
+	_cells.emplace_back(packedCell);
+}
+
+CellDescription PackedDataDescription::unpackCell(PackedCell const & packedCell) const
+{
+	CellDescription result;
+	result.id = packedCell.id;
+	if (packedCell.flags & PackedCell::HasPos) {
+		result.pos = packedCell.pos;
+	}
+	if (packedCell.flags & PackedCell::HasEnergy) {
+		result.energy = packedCell.energy;
+	}
+	if (packedCell.flags & PackedCell::HasMaxConnections) {
+		result.maxConnections = packedCell.maxConnections;
+	}
+	if (packedCell.flags & PackedCell::HasConnectingCells) {
+		list<uint64_t> connectingCells;
+		for (int index = 0; index < packedCell.numConnections; ++index) {
+			if (index < PackedCell::NumInlineConnections) {
+				connectingCells.emplace_back(packedCell.connections[index]);
+			}
+			else {
+				uint64_t connectingCell;
+				auto const spilledIndex = index - PackedCell::NumInlineConnections;
+				std::memcpy(&connectingCell, &_arena[packedCell.spilledConnections.offset + spilledIndex * sizeof(uint64_t)], sizeof(uint64_t));
+				connectingCells.emplace_back(connectingCell);
+			}
+		}
+		result.connectingCells = std::move(connectingCells);
+	}
+	if (packedCell.flags & PackedCell::HasTokenBlocked) {
+		result.tokenBlocked = (packedCell.flags & PackedCell::TokenBlocked) != 0;
+	}
+	if (packedCell.flags & PackedCell::HasTokenBranchNumber) {
+		result.tokenBranchNumber = packedCell.tokenBranchNumber;
+	}
+	if (packedCell.flags & PackedCell::HasMetadata) {
+		CellMetadata metadata;
+		metadata.computerSourcecode = getString(packedCell.computerSourcecode);
+		metadata.name = getString(packedCell.name);
+		metadata.description = getString(packedCell.description);
+		metadata.color = packedCell.color;
+		result.metadata = metadata;
+	}
+	if (packedCell.flags & PackedCell::HasCellFeature) {
+		result.cellFeature = CellFeatureDescription()
+			.setType(static_cast<Enums::CellFunction::Type>(packedCell.featureType))
+			.setVolatileData(getByteArray(packedCell.volatileData))
+			.setConstData(getByteArray(packedCell.constData));
+	}
+	if (packedCell.flags & PackedCell::HasTokens) {
+		vector<TokenDescription> tokens;
+		tokens.reserve(packedCell.numTokens);
+		for (int index = 0; index < packedCell.numTokens; ++index) {
+			auto const& packedToken = _tokens[packedCell.tokenStartIndex + index];
+			TokenDescription token;
+			if (packedToken.flags & PackedToken::HasEnergy) {
+				token.energy = packedToken.energy;
+			}
+			if (packedToken.flags & PackedToken::HasData) {
+				token.data = getByteArray(packedToken.data);
+			}
+			tokens.emplace_back(token);
+		}
+		result.tokens = std::move(tokens);
+	}
+	if (packedCell.flags & PackedCell::HasTokenUsages) {
+		result.tokenUsages = packedCell.tokenUsages;
+	}
+	return result;
+}
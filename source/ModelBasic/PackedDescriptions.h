@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Descriptions.h"
+
+/**
+ * Compact representation of a DataDescription for bulk data that is stored rather than edited
+ * (e.g. undo stack, snapshots). Cells, tokens, clusters and particles are kept in flat arrays,
+ * cell connections are stored inline and all payload bytes (feature data, token data, metadata
+ * strings) are placed in a single arena. Descriptions are unpacked where editors need them.
+ */
+
+//byte range in the arena of a PackedDataDescription
+struct PackedBytes
+{
+	uint32_t offset = 0;
+	uint32_t size = 0;
+};
+
+struct PackedToken
+{
+	enum Flags : uint8_t { HasEnergy = 1, HasData = 2 };
+
+	double energy = 0;
+	PackedBytes data;
+	uint8_t flags = 0;
+};
+
+struct PackedCell
+{
+	enum Flags : uint16_t {
+		HasPos = 1 << 0, HasEnergy = 1 << 1, HasMaxConnections = 1 << 2, HasConnectingCells = 1 << 3,
+		HasTokenBlocked = 1 << 4, HasTokenBranchNumber = 1 << 5, HasMetadata = 1 << 6, HasCellFeature = 1 << 7,
+		HasTokens = 1 << 8, HasTokenUsages = 1 << 9, TokenBlocked = 1 << 10
+	};
+	//corresponds to MAX_CELL_BONDS of the simulation, further connections are spilled to the arena
+	static int const NumInlineConnections = 6;
+
+	uint64_t id = 0;
+	uint64_t connections[NumInlineConnections];
+	PackedBytes spilledConnections;
+	double energy = 0;
+	QVector2D pos;
+	int maxConnections = 0;
+	int tokenBranchNumber = 0;
+	int tokenUsages = 0;
+	uint32_t tokenStartIndex = 0;
+	uint16_t numTokens = 0;
+	uint16_t numConnections = 0;
+	uint16_t flags = 0;
+	uint8_t featureType = 0;
+	uint8_t color = 0;
+	PackedBytes volatileData;
+	PackedBytes constData;
+	PackedBytes computerSourcecode;
+	PackedBytes name;
+	PackedBytes description;
+};
+
+struct PackedCluster
+{
+	enum Flags : uint8_t { HasPos = 1, HasVel = 2, HasAngle = 4, HasAngularVel = 8, HasMetadata = 16, HasCells = 32 };
+
+	uint64_t id = 0;
+	QVector2D pos;
+	QVector2D vel;
+	double angle = 0;
+	double angularVel = 0;
+	PackedBytes name;
+	uint32_t cellStartIndex = 0;
+	uint32_t numCells = 0;
+	uint8_t flags = 0;
+};
+
+struct PackedParticle
+{
+	enum Flags : uint8_t { HasPos = 1, HasVel = 2, HasEnergy = 4, HasMetadata = 8 };
+
+	uint64_t id = 0;
+	QVector2D pos;
+	QVector2D vel;
+	double energy = 0;
+	uint8_t color = 0;
+	uint8_t flags = 0;
+};
+
+class MODELBASIC_EXPORT PackedDataDescription
+{
+public:
+	PackedDataDescription() = default;
+	PackedDataDescription(DataDescription const& data);
+
+	DataDescription unpack() const;
+	ClusterDescription unpackCluster(int clusterIndex) const;
+	ParticleDescription unpackParticle(int particleIndex) const;
+
+	int getNumClusters() const { return _clusters.size(); }
+	int getNumCells() const { return _cells.size(); }
+	int getNumParticles() const { return _particles.size(); }
+	bool isEmpty() const { return _clusters.empty() && _particles.empty(); }
+
+	size_t getMemoryUsage() const;
+	static size_t estimateMemoryUsage(DataDescription const& data);	//heap usage of the unpacked representation
+
+private:
+	PackedBytes addBytes(void const* data, size_t size);
+	PackedBytes addByteArray(QByteArray const& value);
+	PackedBytes addString(QString const& value);
+	QByteArray getByteArray(PackedBytes const& bytes) const;
+	QString getString(PackedBytes const& bytes) const;
+
+	void addCell(CellDescription const& cell);
+	CellDescription unpackCell(PackedCell const& cell) const;
+
+	bool _hasClusters = false;
+	bool _hasParticles = false;
+	vector<PackedCluster> _clusters;
+	vector<PackedCell> _cells;
+	vector<PackedToken> _tokens;
+	vector<PackedParticle> _particles;
+	vector<char> _arena;
+};
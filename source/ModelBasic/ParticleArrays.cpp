@@ -0,0 +1,113 @@
+#include "Base/NumberGenerator.h"
+
+#include "ParticleArrays.h"
+
+ParticleArrays::ParticleArrays(vector<ParticleDescription> const & particles)
+{
+	int const numParticles = particles.size();
+	ids.resize(numParticles);
+	posX.resize(numParticles);
+	posY.resize(numParticles);
+	velX.resize(numParticles);
+	velY.resize(numParticles);
+	energies.resize(numParticles);
+	colors.resize(numParticles);
+	alive.assign(numParticles, 1);
+	for (int index = 0; index < numParticles; ++index) {
+		auto const& particle = particles[index];
+		auto const pos = particle.pos.get_value_or({});
+		auto const vel = particle.vel.get_value_or({});
+		ids[index] = particle.id;
+		posX[index] = pos.x();
+		posY[index] = pos.y();
+		velX[index] = vel.x();
+		velY[index] = vel.y();
+		energies[index] = static_cast<float>(particle.energy.get_value_or(0));
+		colors[index] = particle.metadata.get_value_or(ParticleMetadata()).color;
+	}
+}
+
+vector<ParticleDescription> ParticleArrays::toDescriptions() const
+{
+	vector<ParticleDescription> result;
+	result.reserve(getNumParticles());
+	for (int index = 0; index < getNumParticles(); ++index) {
+		if (0 == alive[index]) {
+			continue;
+		}
+		ParticleMetadata metadata;
+		metadata.color = colors[index];
+		result.emplace_back(ParticleDescription().setId(ids[index]).setPos({ posX[index], posY[index] })
+			.setVel({ velX[index], velY[index] }).setEnergy(energies[index]).setMetadata(metadata));
+	}
+	return result;
+}
+
+void ParticleArrays::move(TorusMetric const & metric)
+{
+	int const numParticles = getNumParticles();
+	auto const sizeX = static_cast<float>(metric.getSizeX());
+	auto const sizeY = static_cast<float>(metric.getSizeY());
+	float* x = posX.data();
+	float* y = posY.data();
+	float const* vx = velX.data();
+	float const* vy = velY.data();
+
+	//branch-free wrapping for particles which leave the universe by less than its size
+	for (int index = 0; index < numParticles; ++index) {
+		auto const newX = x[index] + vx[index];
+		auto const newY = y[index] + vy[index];
+		x[index] = newX < 0 ? newX + sizeX : (newX >= sizeX ? newX - sizeX : newX);
+		y[index] = newY < 0 ? newY + sizeY : (newY >= sizeY ? newY - sizeY : newY);
+	}
+
+	//remaining (rare) cases: very fast particles and rounding to the universe size
+	for (int index = 0; index < numParticles; ++index) {
+		if (x[index] < 0 || x[index] >= sizeX || y[index] < 0 || y[index] >= sizeY) {
+			metric.correctPosition(x[index], y[index]);
+		}
+	}
+}
+
+void ParticleArrays::getTransformationCandidates(float probability, float minInnerEnergy, NumberGenerator * numberGen, vector<int>& result) const
+{
+	result.clear();
+	int const numParticles = getNumParticles();
+	vector<float> randomValues(numParticles);
+	numberGen->getRandomReals(randomValues.data(), numParticles);
+
+	for (int index = 0; index < numParticles; ++index) {
+		auto const innerEnergy = energies[index] - 0.5f * (velX[index] * velX[index] + velY[index] * velY[index]);
+		if (1 == alive[index] && randomValues[index] < probability && innerEnergy >= minInnerEnergy) {
+			result.emplace_back(index);
+		}
+	}
+}
+
+void ParticleArrays::removeDeadParticles()
+{
+	int const numParticles = getNumParticles();
+	int numAliveParticles = 0;
+	for (int index = 0; index < numParticles; ++index) {
+		if (0 == alive[index]) {
+			continue;
+		}
+		ids[numAliveParticles] = ids[index];
+		posX[numAliveParticles] = posX[index];
+		posY[numAliveParticles] = posY[index];
+		velX[numAliveParticles] = velX[index];
+		velY[numAliveParticles] = velY[index];
+		energies[numAliveParticles] = energies[index];
+		colors[numAliveParticles] = colors[index];
+		alive[numAliveParticles] = 1;
+		++numAliveParticles;
+	}
+	ids.resize(numAliveParticles);
+	posX.resize(numAliveParticles);
+	posY.resize(numAliveParticles);
+	velX.resize(numAliveParticles);
+	velY.resize(numAliveParticles);
+	energies.resize(numAliveParticles);
+	colors.resize(numAliveParticles);
+	alive.resize(numAliveParticles);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Descriptions.h"
+#include "TorusMetric.h"
+
+/**
+ * Particles in structure-of-arrays layout for host-side processing.
+ * The per-particle work is done in plain loops over contiguous arrays which the compiler vectorizes.
+ */
+struct MODELBASIC_EXPORT ParticleArrays
+{
+	vector<uint64_t> ids;
+	vector<float> posX;
+	vector<float> posY;
+	vector<float> velX;
+	vector<float> velY;
+	vector<float> energies;
+	vector<uint8_t> colors;
+	vector<uint8_t> alive;	//0 = dead, 1 = alive
+
+	ParticleArrays() = default;
+	ParticleArrays(vector<ParticleDescription> const& particles);
+
+	vector<ParticleDescription> toDescriptions() const;
+	int getNumParticles() const { return ids.size(); }
+
+	//moves the particles by their velocities and maps them into the universe
+	void move(TorusMetric const& metric);
+
+	//alive particles with given probability whose energy without kinetic energy is at least minInnerEnergy
+	void getTransformationCandidates(float probability, float minInnerEnergy, NumberGenerator* numberGen, vector<int>& result) const;
+
+	//removes dead particles while preserving the order of the others
+	void removeDeadParticles();
+};
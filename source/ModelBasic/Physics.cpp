@@ -98,11 +98,6 @@ double Physics::angularMass(vector<QVector2D> const & relPositionOfMasses)
 
 double Physics::angularMomentum(Velocities const & velocities, vector<QVector2D> const & relPositionOfMasses)
 {
-	vector<QVector2D> relVel;
-	std::transform(
-		relPositionOfMasses.begin(), relPositionOfMasses.end(), std::inserter(relVel, relVel.begin()),
-		[&velocities](QVector2D const& relPos) { return tangentialVelocity(relPos, velocities); });
-
 	auto result = 0.0;
 	for (auto const& relPos : relPositionOfMasses) {
 		auto relVel = tangentialVelocity(relPos, velocities) - velocities.linear;
@@ -111,6 +106,59 @@ double Physics::angularMomentum(Velocities const & velocities, vector<QVector2D>
 	return result;
 }
 
+namespace
+{
+	//independent partial sums allow the compiler to keep the lanes in SIMD registers
+	int const NumLanes = 4;
+
+	template<typename Func>
+	double sumUp(int numElements, Func const& func)
+	{
+		double partialSums[NumLanes] = { 0.0, 0.0, 0.0, 0.0 };
+		int index = 0;
+		for (; index + NumLanes <= numElements; index += NumLanes) {
+			for (int lane = 0; lane < NumLanes; ++lane) {
+				partialSums[lane] += func(index + lane);
+			}
+		}
+		for (; index < numElements; ++index) {
+			partialSums[0] += func(index);
+		}
+		return (partialSums[0] + partialSums[1]) + (partialSums[2] + partialSums[3]);
+	}
+}
+
+QVector2D Physics::centerOfMass(double const * x, double const * y, int numMasses)
+{
+	CHECK(numMasses > 0);
+	auto const sumX = sumUp(numMasses, [x](int index) { return x[index]; });
+	auto const sumY = sumUp(numMasses, [y](int index) { return y[index]; });
+	return QVector2D(sumX / numMasses, sumY / numMasses);
+}
+
+double Physics::angularMass(double const * x, double const * y, int numMasses, QVector2D const & center)
+{
+	double const centerX = center.x();
+	double const centerY = center.y();
+	return sumUp(numMasses, [=](int index) {
+		auto const relX = x[index] - centerX;
+		auto const relY = y[index] - centerY;
+		return relX * relX + relY * relY;
+	});
+}
+
+double Physics::angularMomentum(double const * x, double const * y, double const * velX, double const * velY, int numMasses,
+	QVector2D const & center, QVector2D const & velOfCenter)
+{
+	double const centerX = center.x();
+	double const centerY = center.y();
+	double const velOfCenterX = velOfCenter.x();
+	double const velOfCenterY = velOfCenter.y();
+	return sumUp(numMasses, [=](int index) {
+		return (x[index] - centerX) * (velY[index] - velOfCenterY) - (y[index] - centerY) * (velX[index] - velOfCenterX);
+	});
+}
+
 double Physics::angularVelocity (double angularMassOld, double angularMassNew, double angularVelOld)
 {
     angularVelOld = angularVelOld*degToRad;
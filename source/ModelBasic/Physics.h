@@ -27,6 +27,12 @@ public:
 	static double angularMass(vector<QVector2D> const& relPositionOfMasses);
 	static double angularMomentum(Velocities const& velocities, vector<QVector2D> const& relPositionOfMasses);
 
+	//batch variants for large sets of masses in structure-of-arrays layout (x[i], y[i])
+	static QVector2D centerOfMass(double const* x, double const* y, int numMasses);
+	static double angularMass(double const* x, double const* y, int numMasses, QVector2D const& center);
+	static double angularMomentum(double const* x, double const* y, double const* velX, double const* velY, int numMasses,
+		QVector2D const& center, QVector2D const& velOfCenter);
+
 	static QVector2D tangentialVelocity(QVector2D positionFromCenter, Velocities const& velocityOfCenter);
 	static double angularMomentum(QVector2D positionFromCenter, QVector2D velocity);
 	static double angularVelocity(double angularMassOld, double angularMassNew, double angularVelOld);
@@ -252,6 +252,7 @@ void SerializerImpl::serialize(SimulationController * simController, int typeId,
 			newSettings->typeSpecificData,
 			context->getTimestep()
 		};
+        _descHelper->init(context);
         _duplicationSettings.enabled = newSettings->duplicateContent;
         _duplicationSettings.origUniverseSize = universeSize;
         _duplicationSettings.count = {
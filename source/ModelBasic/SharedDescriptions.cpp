@@ -0,0 +1,89 @@
+#include "Base/Parallel.h"
+
+#include "ChangeDescriptions.h"
+#include "SharedDescriptions.h"
+
+SharedDataDescription::SharedDataDescription(DataDescription data)
+{
+	init(data, nullptr);
+}
+
+SharedDataDescription::SharedDataDescription(DataDescription data, SharedDataDescription const & base)
+{
+	init(data, &base);
+}
+
+DataDescription SharedDataDescription::toDataDescription() const
+{
+	DataDescription result;
+	if (_clusters) {
+		result.clusters = vector<ClusterDescription>();
+		result.clusters->reserve(_clusters->size());
+		for (auto const& entry : *_clusters) {
+			result.clusters->emplace_back(*entry.cluster);
+		}
+	}
+	if (_particles) {
+		result.particles = *_particles;
+	}
+	return result;
+}
+
+ClusterDescription & SharedDataDescription::getClusterRef(int index)
+{
+	if (_clusters.use_count() > 1) {
+		_clusters = std::make_shared<vector<ClusterEntry>>(*_clusters);
+	}
+	auto& entry = _clusters->at(index);
+	if (entry.cluster.use_count() > 1) {
+		entry.cluster = std::make_shared<ClusterDescription>(*entry.cluster);
+	}
+	entry.hash = 0;
+	return *entry.cluster;
+}
+
+ParticleDescription & SharedDataDescription::getParticleRef(int index)
+{
+	if (_particles.use_count() > 1) {
+		_particles = std::make_shared<vector<ParticleDescription>>(*_particles);
+	}
+	return _particles->at(index);
+}
+
+void SharedDataDescription::init(DataDescription & data, SharedDataDescription const * base)
+{
+	if (data.clusters) {
+		auto& clusters = *data.clusters;
+		int const numClusters = clusters.size();
+		_clusters = std::make_shared<vector<ClusterEntry>>(numClusters);
+
+		FlatHashMap<uint64_t, int> baseIndicesByIds;
+		if (base && base->_clusters) {
+			baseIndicesByIds.reserve(base->_clusters->size());
+			for (int index = 0; index < base->_clusters->size(); ++index) {
+				baseIndicesByIds.insert_or_assign(base->_clusters->at(index).cluster->id, index);
+			}
+		}
+
+		executeInParallel(numClusters, [&](int index) {
+			auto& cluster = clusters[index];
+			auto& entry = _clusters->at(index);
+			entry.hash = cluster.getHash();
+
+			auto baseIndexIt = baseIndicesByIds.find(cluster.id);
+			if (baseIndexIt != baseIndicesByIds.end()) {
+				auto const& baseEntry = base->_clusters->at(baseIndexIt->second);
+				//equal hashes are confirmed by content => collisions cannot lead to stale clusters
+				if (0 != baseEntry.hash && baseEntry.hash == entry.hash
+					&& ClusterChangeDescription(*baseEntry.cluster, cluster).isEmpty()) {
+					entry.cluster = baseEntry.cluster;
+					return;
+				}
+			}
+			entry.cluster = std::make_shared<ClusterDescription>(std::move(cluster));
+		});
+	}
+	if (data.particles) {
+		_particles = std::make_shared<vector<ParticleDescription>>(std::move(*data.particles));
+	}
+}
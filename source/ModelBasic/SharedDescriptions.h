@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Descriptions.h"
+
+/**
+ * DataDescription with structural sharing: copies are O(1) and share all clusters and particles.
+ * Clusters are copied on write individually, the particle array as a whole.
+ * It is intended for data which is kept for later use (e.g. undo stack, clipboard).
+ */
+class MODELBASIC_EXPORT SharedDataDescription
+{
+public:
+	SharedDataDescription() = default;
+	SharedDataDescription(DataDescription data);
+	//clusters whose content is equal to the content in base are shared with base
+	SharedDataDescription(DataDescription data, SharedDataDescription const& base);
+
+	DataDescription toDataDescription() const;
+
+	bool isEmpty() const { return 0 == getNumClusters() && 0 == getNumParticles(); }
+	int getNumClusters() const { return _clusters ? _clusters->size() : 0; }
+	int getNumParticles() const { return _particles ? _particles->size() : 0; }
+
+	ClusterDescription const& getCluster(int index) const { return *_clusters->at(index).cluster; }
+	ParticleDescription const& getParticle(int index) const { return _particles->at(index); }
+	ClusterDescription& getClusterRef(int index);
+	ParticleDescription& getParticleRef(int index);
+
+private:
+	struct ClusterEntry
+	{
+		shared_ptr<ClusterDescription> cluster;
+		uint64_t hash = 0;	//0 if unknown
+	};
+	void init(DataDescription& data, SharedDataDescription const* base);
+
+	shared_ptr<vector<ClusterEntry>> _clusters;
+	shared_ptr<vector<ParticleDescription>> _particles;
+};
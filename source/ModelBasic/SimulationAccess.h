@@ -17,6 +17,7 @@ public:
 	virtual void updateData(DataChangeDescription const &desc) = 0;
 	virtual void requireData(IntRect rect, ResolveDescription const& resolveDesc) = 0;
     virtual void requireData(ResolveDescription const& resolveDesc) = 0;
+    //rect is scaled down to the size of target if necessary
     virtual void requireImage(IntRect rect, QImagePtr const& target, std::mutex& mutex) = 0;
     virtual void applyAction(PhysicalAction const& action) = 0;
 
@@ -8,12 +8,14 @@ SpaceProperties::SpaceProperties(QObject * parent)
 void SpaceProperties::init(IntVector2D size)
 {
 	_size = size;
+	_torusMetric = TorusMetric(size.x, size.y);
 }
 
 SpaceProperties * SpaceProperties::clone(QObject * parent) const
 {
 	auto metric = new SpaceProperties(parent);
 	metric->_size = _size;
+	metric->_torusMetric = _torusMetric;
 	return metric;
 }
 
@@ -24,44 +26,30 @@ IntVector2D SpaceProperties::getSize() const
 
 void SpaceProperties::correctPosition(QVector2D & pos) const
 {
-	IntVector2D intPart{ qFloor(pos.x()), qFloor(pos.y()) };
-	qreal fracPartX = pos.x() - intPart.x;
-	qreal fracPartY = pos.y() - intPart.y;
-	correctPositionInline(intPart);
-	pos.setX(static_cast<qreal>(intPart.x) + fracPartX);
-	pos.setY(static_cast<qreal>(intPart.y) + fracPartY);
+	_torusMetric.correctPosition(pos);
 }
 
 void SpaceProperties::correctPosition(IntVector2D & pos) const
 {
-	correctPositionInline(pos);
+	_torusMetric.correctPosition(pos);
 }
 
 IntVector2D SpaceProperties::convertToIntVector(QVector2D const & pos) const
 {
-	IntVector2D intPos;
-	intPos.x = static_cast<int>(pos.x());
-	if (intPos.x < 0) {
-		--intPos.x;
-	}
-	intPos.y = static_cast<int>(pos.y());
-	if (intPos.y < 0) {
-		--intPos.y;
-	}
-	return intPos;
+	return TorusMetric::convertToIntVector(pos);
 }
 
 IntVector2D SpaceProperties::correctPositionAndConvertToIntVector(QVector2D const& pos) const
 {
 	IntVector2D intPos = convertToIntVector(pos);
-	correctPositionInline(intPos);
+	_torusMetric.correctPosition(intPos);
 	return intPos;
 }
 
 IntVector2D SpaceProperties::shiftPosition(IntVector2D const & pos, IntVector2D const && shift) const
 {
 	IntVector2D temp{ pos.x + shift.x, pos.y + shift.y };
-	correctPositionInline(temp);
+	_torusMetric.correctPosition(temp);
 	return temp;
 }
 
@@ -73,16 +61,7 @@ void SpaceProperties::truncateRect(IntRect & rect) const
 
 void SpaceProperties::correctDisplacement(QVector2D & displacement) const
 {
-	IntVector2D intDisplacement{ qFloor(displacement.x()), qFloor(displacement.y()) };
-	qreal rx = displacement.x() - static_cast<qreal>(intDisplacement.x);
-	qreal ry = displacement.y() - static_cast<qreal>(intDisplacement.y);
-	intDisplacement.x += _size.x / 2;
-	intDisplacement.y += _size.y / 2;
-	correctPositionInline(intDisplacement);
-	intDisplacement.x -= _size.x / 2;
-	intDisplacement.y -= _size.y / 2;
-	displacement.setX(static_cast<qreal>(intDisplacement.x) + rx);
-	displacement.setY(static_cast<qreal>(intDisplacement.y) + ry);
+	_torusMetric.correctDisplacement(displacement);
 }
 
 QVector2D SpaceProperties::displacement(QVector2D fromPoint, QVector2D toPoint) const
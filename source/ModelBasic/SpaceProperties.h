@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Definitions.h"
+#include "TorusMetric.h"
 
 class MODELBASIC_EXPORT SpaceProperties
 	: public QObject
@@ -28,15 +29,11 @@ public:
 	virtual qreal distance(QVector2D fromPoint, QVector2D toPoint) const;
 	virtual IntVector2D shiftPosition(IntVector2D const& pos, IntVector2D const && shift) const;
 
-private:
-	inline void correctPositionInline(IntVector2D & pos) const;
+	//non-virtual access to the metric for hot loops
+	TorusMetric const& getTorusMetric() const { return _torusMetric; }
 
+private:
 	IntVector2D _size{ 0, 0 };
+	TorusMetric _torusMetric;
 };
 
-void SpaceProperties::correctPositionInline(IntVector2D & pos) const
-{
-	pos.x = ((pos.x % _size.x) + _size.x) % _size.x;
-	pos.y = ((pos.y % _size.y) + _size.y) % _size.y;
-}
-
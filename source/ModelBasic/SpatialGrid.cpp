@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <numeric>
+
+#include "SpatialGrid.h"
+
+namespace
+{
+	//dense bucket starts are used as long as they do not exceed this factor times the number of points
+	int const MaxDenseBucketsPerPoint = 4;
+}
+
+void SpatialGrid::build(vector<int> const & posX, vector<int> const & posY, int bucketSize)
+{
+	clear();
+	int const numPoints = posX.size();
+	if (0 == numPoints) {
+		return;
+	}
+
+	_bucketSize = std::max(1, bucketSize);
+	auto const minMaxX = std::minmax_element(posX.begin(), posX.end());
+	auto const minMaxY = std::minmax_element(posY.begin(), posY.end());
+	_origin = { *minMaxX.first, *minMaxY.first };
+	_size = { (*minMaxX.second - _origin.x) / _bucketSize + 1, (*minMaxY.second - _origin.y) / _bucketSize + 1 };
+
+	vector<int64_t> keys(numPoints);
+	for (int index = 0; index < numPoints; ++index) {
+		keys[index] = getBucketKey((posX[index] - _origin.x) / _bucketSize, (posY[index] - _origin.y) / _bucketSize);
+	}
+
+	_indices.resize(numPoints);
+	auto const numBuckets = static_cast<int64_t>(_size.x) * _size.y;
+	if (numBuckets <= static_cast<int64_t>(numPoints) * MaxDenseBucketsPerPoint) {
+
+		//counting sort into dense buckets
+		_bucketStarts.assign(numBuckets + 1, 0);
+		for (auto const& key : keys) {
+			++_bucketStarts[key + 1];
+		}
+		std::partial_sum(_bucketStarts.begin(), _bucketStarts.end(), _bucketStarts.begin());
+		vector<int> insertIndices(_bucketStarts.begin(), _bucketStarts.end() - 1);
+		for (int index = 0; index < numPoints; ++index) {
+			_indices[insertIndices[keys[index]]++] = index;
+		}
+	}
+	else {
+
+		//sorted cell list with occupied buckets only
+		std::iota(_indices.begin(), _indices.end(), 0);
+		std::stable_sort(_indices.begin(), _indices.end(), [&keys](int index1, int index2) {
+			return keys[index1] < keys[index2];
+		});
+		for (int sortedIndex = 0; sortedIndex < numPoints; ++sortedIndex) {
+			auto const key = keys[_indices[sortedIndex]];
+			if (_occupiedBucketKeys.empty() || _occupiedBucketKeys.back() != key) {
+				_occupiedBucketKeys.emplace_back(key);
+				_occupiedBucketStarts.emplace_back(sortedIndex);
+			}
+		}
+		_occupiedBucketStarts.emplace_back(numPoints);
+	}
+
+	_posX.resize(numPoints);
+	_posY.resize(numPoints);
+	for (int sortedIndex = 0; sortedIndex < numPoints; ++sortedIndex) {
+		_posX[sortedIndex] = posX[_indices[sortedIndex]];
+		_posY[sortedIndex] = posY[_indices[sortedIndex]];
+	}
+}
+
+void SpatialGrid::clear()
+{
+	_origin = { 0, 0 };
+	_size = { 0, 0 };
+	_indices.clear();
+	_posX.clear();
+	_posY.clear();
+	_bucketStarts.clear();
+	_occupiedBucketKeys.clear();
+	_occupiedBucketStarts.clear();
+}
+
+void SpatialGrid::getRowRange(int bucketY, int bucketX0, int bucketX1, int & begin, int & end) const
+{
+	auto const key0 = getBucketKey(bucketX0, bucketY);
+	auto const key1 = getBucketKey(bucketX1, bucketY);
+	if (isDense()) {
+		begin = _bucketStarts[key0];
+		end = _bucketStarts[key1 + 1];
+		return;
+	}
+	auto const keyBegin = std::lower_bound(_occupiedBucketKeys.begin(), _occupiedBucketKeys.end(), key0);
+	auto const keyEnd = std::upper_bound(keyBegin, _occupiedBucketKeys.end(), key1);
+	begin = _occupiedBucketStarts[keyBegin - _occupiedBucketKeys.begin()];
+	end = _occupiedBucketStarts[keyEnd - _occupiedBucketKeys.begin()];
+}
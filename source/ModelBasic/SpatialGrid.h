@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Definitions.h"
+
+/**
+ * Uniform grid over integer points, built by sorting the points into square buckets.
+ * Points are stored bucket by bucket with positions in structure-of-arrays layout.
+ * Memory is proportional to the number of points: bucket starts are stored densely only if the
+ * bounding box of the points is small (e.g. small universes), otherwise only occupied buckets are kept.
+ */
+class MODELBASIC_EXPORT SpatialGrid
+{
+public:
+	void build(vector<int> const& posX, vector<int> const& posY, int bucketSize);
+	void clear();
+
+	int getNumPoints() const { return _indices.size(); }
+	bool isDense() const { return !_bucketStarts.empty(); }
+
+	//calls func(index, x, y) for all points with |x - pos.x| <= radius and |y - pos.y| <= radius
+	template<typename Func>
+	void forEachInRange(IntVector2D const& pos, int radius, Func const& func) const;
+
+private:
+	int64_t getBucketKey(int bucketX, int bucketY) const
+	{
+		return static_cast<int64_t>(bucketY) * _size.x + bucketX;
+	}
+	//range of sorted points in the buckets [bucketX0, bucketX1] of a row
+	void getRowRange(int bucketY, int bucketX0, int bucketX1, int& begin, int& end) const;
+
+	int _bucketSize = 1;
+	IntVector2D _origin = { 0, 0 };
+	IntVector2D _size = { 0, 0 };	//in buckets
+
+	vector<int> _indices;
+	vector<int> _posX;
+	vector<int> _posY;
+
+	vector<int> _bucketStarts;	//dense: points of bucket b are [_bucketStarts[b], _bucketStarts[b + 1])
+	vector<int64_t> _occupiedBucketKeys;	//sparse: sorted keys of occupied buckets
+	vector<int> _occupiedBucketStarts;
+};
+
+template<typename Func>
+void SpatialGrid::forEachInRange(IntVector2D const & pos, int radius, Func const & func) const
+{
+	if (_indices.empty()) {
+		return;
+	}
+	int const x0 = pos.x - radius - _origin.x;
+	int const y0 = pos.y - radius - _origin.y;
+	int const x1 = std::min(pos.x + radius - _origin.x, _size.x * _bucketSize - 1);
+	int const y1 = std::min(pos.y + radius - _origin.y, _size.y * _bucketSize - 1);
+	if (x1 < 0 || y1 < 0 || x0 > x1 || y0 > y1) {	//range outside of the grid
+		return;
+	}
+	int const bucketX0 = std::max(x0, 0) / _bucketSize;
+	int const bucketY0 = std::max(y0, 0) / _bucketSize;
+	int const bucketX1 = x1 / _bucketSize;
+	int const bucketY1 = y1 / _bucketSize;
+
+	for (int bucketY = bucketY0; bucketY <= bucketY1; ++bucketY) {
+		int begin, end;
+		getRowRange(bucketY, bucketX0, bucketX1, begin, end);
+		for (int sortedIndex = begin; sortedIndex < end; ++sortedIndex) {
+			int const x = _posX[sortedIndex];
+			int const y = _posY[sortedIndex];
+			if (std::abs(x - pos.x) <= radius && std::abs(y - pos.y) <= radius) {
+				func(_indices[sortedIndex], x, y);
+			}
+		}
+	}
+}
@@ -1,9 +1,16 @@
+#include <atomic>
+
 #include "SymbolTable.h"
 
+namespace
+{
+	std::atomic<uint64_t> versionCounter{ 0 };
+}
+
 SymbolTable::SymbolTable(QObject* parent)
 	: QObject(parent)
 {
-
+	updateVersion();
 }
 
 SymbolTable * SymbolTable::clone(QObject * parent) const
@@ -16,16 +23,19 @@ SymbolTable * SymbolTable::clone(QObject * parent) const
 void SymbolTable::getSymbolsFrom(SymbolTable const* other)
 {
 	_symbolsByKey = other->_symbolsByKey;
+	updateVersion();
 }
 
 void SymbolTable::addEntry(string const& key, string const& value)
 {
 	_symbolsByKey[key] = value;
+	updateVersion();
 }
 
 void SymbolTable::delEntry(string const& key)
 {
 	_symbolsByKey.erase(key);
+	updateVersion();
 }
 
 string SymbolTable::getValue(string const& input) const
@@ -39,6 +49,7 @@ string SymbolTable::getValue(string const& input) const
 void SymbolTable::clear()
 {
 	_symbolsByKey.clear();
+	updateVersion();
 }
 
 map<string, string> const& SymbolTable::getEntries() const
@@ -49,10 +60,21 @@ map<string, string> const& SymbolTable::getEntries() const
 void SymbolTable::setEntries(map<string, string> const & table)
 {
 	_symbolsByKey = table;
+	updateVersion();
 }
 
 void SymbolTable::mergeEntries(SymbolTable const& table)
 {
 	_symbolsByKey.insert(table._symbolsByKey.begin(), table._symbolsByKey.end());
+	updateVersion();
 }
 
+uint64_t SymbolTable::getVersion() const
+{
+	return _version;
+}
+
+void SymbolTable::updateVersion()
+{
+	_version = ++versionCounter;
+}
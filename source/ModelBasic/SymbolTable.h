@@ -22,6 +22,12 @@ public:
 	virtual void setEntries(map<string, string> const& table);
 	virtual void mergeEntries(SymbolTable const& table);
 
+	//changes on every modification, versions are unique among all symbol tables
+	virtual uint64_t getVersion() const;
+
 private:
+	void updateVersion();
+
     map<string, string> _symbolsByKey;
+	uint64_t _version = 0;
 };
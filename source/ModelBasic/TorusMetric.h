@@ -0,0 +1,110 @@
+#pragma once
+
+#ifdef __CUDACC__
+#define TORUS_METRIC_FUNCTION __inline__ __host__ __device__
+#else
+#include <QVector2D>
+#include "Base/Definitions.h"
+#define TORUS_METRIC_FUNCTION inline
+#endif
+
+/**
+ * Header-only metric of the torus shaped world. It is a plain value type without virtual calls
+ * such that hot loops on host (via SpaceProperties::getTorusMetric) and device (via MapInfo) can inline it.
+ */
+class TorusMetric
+{
+public:
+	TORUS_METRIC_FUNCTION TorusMetric() {}
+	TORUS_METRIC_FUNCTION TorusMetric(int sizeX, int sizeY) : _sizeX(sizeX), _sizeY(sizeY) {}
+
+	TORUS_METRIC_FUNCTION int getSizeX() const { return _sizeX; }
+	TORUS_METRIC_FUNCTION int getSizeY() const { return _sizeY; }
+
+	//maps value to [0, size), values already inside need no division
+	TORUS_METRIC_FUNCTION static int wrap(int value, int size)
+	{
+		if (static_cast<unsigned int>(value) < static_cast<unsigned int>(size)) {
+			return value;
+		}
+		int const result = value % size;
+		return result < 0 ? result + size : result;
+	}
+
+	//integer part is wrapped, fractional part is preserved
+	TORUS_METRIC_FUNCTION static float wrap(float value, int size)
+	{
+		if (value >= 0 && value < size) {
+			return value;
+		}
+		int const intPart = floorToInt(value);
+		return static_cast<float>(wrap(intPart, size)) + (value - intPart);
+	}
+
+	//maps displacement to [-size/2, size/2) up to the fractional part
+	TORUS_METRIC_FUNCTION static float wrapDisplacement(float value, int size)
+	{
+		int const intPart = floorToInt(value);
+		return static_cast<float>(wrap(intPart + size / 2, size) - size / 2) + (value - intPart);
+	}
+
+	TORUS_METRIC_FUNCTION static int floorToInt(float value)
+	{
+		int const result = static_cast<int>(value);
+		return result > value ? result - 1 : result;
+	}
+
+	TORUS_METRIC_FUNCTION void correctPosition(int& x, int& y) const
+	{
+		x = wrap(x, _sizeX);
+		y = wrap(y, _sizeY);
+	}
+
+	TORUS_METRIC_FUNCTION void correctPosition(float& x, float& y) const
+	{
+		x = wrap(x, _sizeX);
+		y = wrap(y, _sizeY);
+	}
+
+	TORUS_METRIC_FUNCTION void correctDisplacement(float& x, float& y) const
+	{
+		x = wrapDisplacement(x, _sizeX);
+		y = wrapDisplacement(y, _sizeY);
+	}
+
+#ifndef __CUDACC__
+	void correctPosition(IntVector2D& pos) const
+	{
+		correctPosition(pos.x, pos.y);
+	}
+
+	void correctPosition(QVector2D& pos) const
+	{
+		pos = { wrap(pos.x(), _sizeX), wrap(pos.y(), _sizeY) };
+	}
+
+	void correctDisplacement(QVector2D& displacement) const
+	{
+		displacement = { wrapDisplacement(displacement.x(), _sizeX), wrapDisplacement(displacement.y(), _sizeY) };
+	}
+
+	//truncates towards zero and shifts negative values by one (SpaceProperties::convertToIntVector semantics)
+	static IntVector2D convertToIntVector(QVector2D const& pos)
+	{
+		IntVector2D result;
+		result.x = static_cast<int>(pos.x());
+		if (result.x < 0) {
+			--result.x;
+		}
+		result.y = static_cast<int>(pos.y());
+		if (result.y < 0) {
+			--result.y;
+		}
+		return result;
+	}
+#endif
+
+private:
+	int _sizeX = 0;
+	int _sizeY = 0;
+};
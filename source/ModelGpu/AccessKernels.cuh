@@ -11,6 +11,32 @@
 
 #include "SimulationData.cuh"
 
+struct IdSelection
+{
+    uint64_t* ids;  //sorted in ascending order
+    int numIds;
+
+    __device__ __inline__ bool contains(uint64_t id) const
+    {
+        int lower = 0;
+        int upper = numIds - 1;
+        while (lower <= upper) {
+            int const middle = (lower + upper) / 2;
+            auto const& middleId = ids[middle];
+            if (middleId == id) {
+                return true;
+            }
+            if (middleId < id) {
+                lower = middle + 1;
+            }
+            else {
+                upper = middle - 1;
+            }
+        }
+        return false;
+    }
+};
+
 __device__ void copyString(
     int& targetLen,
     int& targetStringIndex,
@@ -28,6 +54,107 @@ __device__ void copyString(
     }
 }
 
+__device__ void copyClusterAccessData_block(Cluster* cluster, PartitionData const& cellBlock, DataAccessTO const& dataTO)
+{
+    __shared__ int cellTOIndex;
+    __shared__ int tokenTOIndex;
+    __shared__ CellAccessTO* cellTOs;
+    __shared__ TokenAccessTO* tokenTOs;
+
+    if (0 == threadIdx.x) {
+        int clusterAccessIndex = atomicAdd(dataTO.numClusters, 1);
+        cellTOIndex = atomicAdd(dataTO.numCells, cluster->numCellPointers);
+        cellTOs = &dataTO.cells[cellTOIndex];
+
+        tokenTOIndex = atomicAdd(dataTO.numTokens, cluster->numTokenPointers);
+        tokenTOs = &dataTO.tokens[tokenTOIndex];
+
+        ClusterAccessTO& clusterTO = dataTO.clusters[clusterAccessIndex];
+        clusterTO.id = cluster->id;
+        clusterTO.pos = cluster->pos;
+        clusterTO.vel = cluster->getVelocity();
+        clusterTO.angle = cluster->angle;
+        clusterTO.angularVel = cluster->getAngularVelocity();
+        clusterTO.numCells = cluster->numCellPointers;
+        clusterTO.numTokens = cluster->numTokenPointers;
+        clusterTO.cellStartIndex = cellTOIndex;
+        clusterTO.tokenStartIndex = tokenTOIndex;
+
+        copyString(
+            clusterTO.metadata.nameLen,
+            clusterTO.metadata.nameStringIndex,
+            cluster->metadata.nameLen,
+            cluster->metadata.name,
+            *dataTO.numStringBytes,
+            dataTO.stringBytes);
+    }
+    __syncthreads();
+
+    cluster->tagCellByIndex_block(cellBlock);
+
+    for (auto cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+        Cell& cell = *cluster->cellPointers[cellIndex];
+        CellAccessTO& cellTO = cellTOs[cellIndex];
+        cellTO.id = cell.id;
+        cellTO.pos = cell.absPos;
+        cellTO.energy = cell.getEnergy_safe();
+        cellTO.maxConnections = cell.maxConnections;
+        cellTO.numConnections = cell.numConnections;
+        cellTO.branchNumber = cell.branchNumber;
+        cellTO.tokenBlocked = cell.tokenBlocked;
+        cellTO.cellFunctionType = cell.getCellFunctionType();
+        cellTO.numStaticBytes = cell.numStaticBytes;
+        cellTO.tokenUsages = cell.tokenUsages;
+        cellTO.metadata.color = cell.metadata.color;
+
+        copyString(
+            cellTO.metadata.nameLen,
+            cellTO.metadata.nameStringIndex,
+            cell.metadata.nameLen,
+            cell.metadata.name,
+            *dataTO.numStringBytes,
+            dataTO.stringBytes);
+        copyString(
+            cellTO.metadata.descriptionLen,
+            cellTO.metadata.descriptionStringIndex,
+            cell.metadata.descriptionLen,
+            cell.metadata.description,
+            *dataTO.numStringBytes,
+            dataTO.stringBytes);
+        copyString(
+            cellTO.metadata.sourceCodeLen,
+            cellTO.metadata.sourceCodeStringIndex,
+            cell.metadata.sourceCodeLen,
+            cell.metadata.sourceCode,
+            *dataTO.numStringBytes,
+            dataTO.stringBytes);
+
+        for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+            cellTO.staticData[i] = cell.staticData[i];
+        }
+        cellTO.numMutableBytes = cell.numMutableBytes;
+        for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
+            cellTO.mutableData[i] = cell.mutableData[i];
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            int connectingCellIndex = cell.connections[i]->tag + cellTOIndex;
+            cellTO.connectionIndices[i] = connectingCellIndex;
+        }
+    }
+
+    PartitionData tokenBlock = calcPartition(cluster->numTokenPointers, threadIdx.x, blockDim.x);
+    for (auto tokenIndex = tokenBlock.startIndex; tokenIndex <= tokenBlock.endIndex; ++tokenIndex) {
+        Token const& token = *cluster->tokenPointers[tokenIndex];
+        TokenAccessTO& tokenTO = tokenTOs[tokenIndex];
+        tokenTO.energy = token.getEnergy();
+        for (int i = 0; i < cudaSimulationParameters.tokenMemorySize; ++i) {
+            tokenTO.memory[i] = token.memory[i];
+        }
+        int tokenCellIndex = token.cell->tag + cellTOIndex;
+        tokenTO.cellIndex = tokenCellIndex;
+    }
+}
+
 __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2 rectLowerRight,
     Array<Cluster*> clusters, DataAccessTO dataTO)
 {
@@ -61,107 +188,39 @@ __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2
         __syncthreads();
 
         if (containedInRect) {
-            __shared__ int cellTOIndex;
-            __shared__ int tokenTOIndex;
-            __shared__ CellAccessTO* cellTOs;
-            __shared__ TokenAccessTO* tokenTOs;
-
-            if (0 == threadIdx.x) {
-                int clusterAccessIndex = atomicAdd(dataTO.numClusters, 1);
-                cellTOIndex = atomicAdd(dataTO.numCells, cluster->numCellPointers);
-                cellTOs = &dataTO.cells[cellTOIndex];
-
-                tokenTOIndex = atomicAdd(dataTO.numTokens, cluster->numTokenPointers);
-                tokenTOs = &dataTO.tokens[tokenTOIndex];
-
-                ClusterAccessTO& clusterTO = dataTO.clusters[clusterAccessIndex];
-                clusterTO.id = cluster->id;
-                clusterTO.pos = cluster->pos;
-                clusterTO.vel = cluster->getVelocity();
-                clusterTO.angle = cluster->angle;
-                clusterTO.angularVel = cluster->getAngularVelocity();
-                clusterTO.numCells = cluster->numCellPointers;
-                clusterTO.numTokens = cluster->numTokenPointers;
-                clusterTO.cellStartIndex = cellTOIndex;
-                clusterTO.tokenStartIndex = tokenTOIndex;
-
-                copyString(
-                    clusterTO.metadata.nameLen,
-                    clusterTO.metadata.nameStringIndex,
-                    cluster->metadata.nameLen,
-                    cluster->metadata.name,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
-            }
-            __syncthreads();
-
-            cluster->tagCellByIndex_block(cellBlock);
-
-            for (auto cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
-                Cell& cell = *cluster->cellPointers[cellIndex];
-                CellAccessTO& cellTO = cellTOs[cellIndex];
-                cellTO.id = cell.id;
-                cellTO.pos = cell.absPos;
-                cellTO.energy = cell.getEnergy_safe();
-                cellTO.maxConnections = cell.maxConnections;
-                cellTO.numConnections = cell.numConnections;
-                cellTO.branchNumber = cell.branchNumber;
-                cellTO.tokenBlocked = cell.tokenBlocked;
-                cellTO.cellFunctionType = cell.getCellFunctionType();
-                cellTO.numStaticBytes = cell.numStaticBytes;
-                cellTO.tokenUsages = cell.tokenUsages;
-                cellTO.metadata.color = cell.metadata.color;
-
-                copyString(
-                    cellTO.metadata.nameLen,
-                    cellTO.metadata.nameStringIndex,
-                    cell.metadata.nameLen,
-                    cell.metadata.name,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
-                copyString(
-                    cellTO.metadata.descriptionLen,
-                    cellTO.metadata.descriptionStringIndex,
-                    cell.metadata.descriptionLen,
-                    cell.metadata.description,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
-                copyString(
-                    cellTO.metadata.sourceCodeLen,
-                    cellTO.metadata.sourceCodeStringIndex,
-                    cell.metadata.sourceCodeLen,
-                    cell.metadata.sourceCode,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
-
-                for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-                    cellTO.staticData[i] = cell.staticData[i];
-                }
-                cellTO.numMutableBytes = cell.numMutableBytes;
-                for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
-                    cellTO.mutableData[i] = cell.mutableData[i];
-                }
-                for (int i = 0; i < cell.numConnections; ++i) {
-                    int connectingCellIndex = cell.connections[i]->tag + cellTOIndex;
-                    cellTO.connectionIndices[i] = connectingCellIndex;
-                }
-            }
+            copyClusterAccessData_block(cluster, cellBlock, dataTO);
+        }
+    }
+}
 
-            PartitionData tokenBlock = calcPartition(cluster->numTokenPointers, threadIdx.x, blockDim.x);
-            for (auto tokenIndex = tokenBlock.startIndex; tokenIndex <= tokenBlock.endIndex; ++tokenIndex) {
-                Token const& token = *cluster->tokenPointers[tokenIndex];
-                TokenAccessTO& tokenTO = tokenTOs[tokenIndex];
-                tokenTO.energy = token.getEnergy();
-                for (int i = 0; i < cudaSimulationParameters.tokenMemorySize; ++i) {
-                    tokenTO.memory[i] = token.memory[i];
-                }
-                int tokenCellIndex = token.cell->tag + cellTOIndex;
-                tokenTO.cellIndex = tokenCellIndex;
-            }
+__global__ void getClusterAccessDataByIds(Array<Cluster*> clusters, IdSelection selection, DataAccessTO dataTO)
+{
+    PartitionData clusterBlock = calcPartition(clusters.getNumEntries(), blockIdx.x, gridDim.x);
+
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+
+        auto const& cluster = clusters.at(clusterIndex);
+        if (nullptr == cluster || !selection.contains(cluster->id)) {
+            continue;
         }
+
+        PartitionData cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        copyClusterAccessData_block(cluster, cellBlock, dataTO);
+        __syncthreads();
     }
 }
 
+__device__ void copyParticleAccessData(Particle const& particle, DataAccessTO const& access)
+{
+    int particleAccessIndex = atomicAdd(access.numParticles, 1);
+    ParticleAccessTO& particleAccess = access.particles[particleAccessIndex];
+
+    particleAccess.id = particle.id;
+    particleAccess.pos = particle.absPos;
+    particleAccess.vel = particle.vel;
+    particleAccess.energy = particle.getEnergy();
+}
+
 __global__ void getParticleAccessData(int2 rectUpperLeft, int2 rectLowerRight,
     SimulationData data, DataAccessTO access)
 {
@@ -171,13 +230,20 @@ __global__ void getParticleAccessData(int2 rectUpperLeft, int2 rectLowerRight,
     for (int particleIndex = particleBlock.startIndex; particleIndex <= particleBlock.endIndex; ++particleIndex) {
         auto const& particle = *data.entities.particlePointers.at(particleIndex);
         if (isContainedInRect(rectUpperLeft, rectLowerRight, particle.absPos)) {
-            int particleAccessIndex = atomicAdd(access.numParticles, 1);
-            ParticleAccessTO& particleAccess = access.particles[particleAccessIndex];
+            copyParticleAccessData(particle, access);
+        }
+    }
+}
 
-            particleAccess.id = particle.id;
-            particleAccess.pos = particle.absPos;
-            particleAccess.vel = particle.vel;
-            particleAccess.energy = particle.getEnergy();
+__global__ void getParticleAccessDataByIds(Array<Particle*> particles, IdSelection selection, DataAccessTO access)
+{
+    PartitionData particleBlock =
+        calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    for (int particleIndex = particleBlock.startIndex; particleIndex <= particleBlock.endIndex; ++particleIndex) {
+        auto const& particle = particles.at(particleIndex);
+        if (nullptr != particle && selection.contains(particle->id)) {
+            copyParticleAccessData(*particle, access);
         }
     }
 }
@@ -238,6 +304,29 @@ __global__ void filterParticles(int2 rectUpperLeft, int2 rectLowerRight, Array<P
     __syncthreads();
 }
 
+__global__ void filterClustersByIds(IdSelection selection, Array<Cluster*> clusters)
+{
+    PartitionData clusterBlock =
+        calcPartition(clusters.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto& cluster = clusters.at(clusterIndex);
+        if (nullptr != cluster && selection.contains(cluster->id)) {
+            cluster = nullptr;
+        }
+    }
+}
+
+__global__ void filterParticlesByIds(IdSelection selection, Array<Particle*> particles)
+{
+    PartitionData particleBlock =
+        calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int particleIndex = particleBlock.startIndex; particleIndex <= particleBlock.endIndex; ++particleIndex) {
+        auto& particle = particles.getArrayForDevice()[particleIndex];
+        if (nullptr != particle && selection.contains(particle->id)) {
+            particle = nullptr;
+        }
+    }
+}
 
 __global__ void createDataFromTO(SimulationData data, DataAccessTO simulationTO)
 {
@@ -278,6 +367,19 @@ __global__ void getSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
     KERNEL_CALL(getParticleAccessData, rectUpperLeft, rectLowerRight, data, access);
 }
 
+__global__ void getSimulationAccessDataByIds(IdSelection selection, SimulationData data, DataAccessTO access)
+{
+    *access.numClusters = 0;
+    *access.numCells = 0;
+    *access.numParticles = 0;
+    *access.numTokens = 0;
+    *access.numStringBytes = 0;
+
+    KERNEL_CALL(getClusterAccessDataByIds, data.entities.clusterPointers, selection, access);
+    KERNEL_CALL(getClusterAccessDataByIds, data.entities.clusterFreezedPointers, selection, access);
+    KERNEL_CALL(getParticleAccessDataByIds, data.entities.particlePointers, selection, access);
+}
+
 __global__ void setSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
     SimulationData data, DataAccessTO access)
 {
@@ -291,6 +393,18 @@ __global__ void setSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
     KERNEL_CALL_1_1(cleanupAfterDataManipulation, data);
 }
 
+__global__ void setSimulationAccessDataByIds(IdSelection selection, SimulationData data, DataAccessTO access)
+{
+    KERNEL_CALL_1_1(unfreeze, data);
+    data.entities.clusterFreezedPointers.reset();
+
+    KERNEL_CALL(filterClustersByIds, selection, data.entities.clusterPointers);
+    KERNEL_CALL(filterParticlesByIds, selection, data.entities.particlePointers);
+    KERNEL_CALL(createDataFromTO, data, access);
+
+    KERNEL_CALL_1_1(cleanupAfterDataManipulation, data);
+}
+
 __global__ void clearData(SimulationData data)
 {
     data.entities.clusterFreezedPointers.reset();
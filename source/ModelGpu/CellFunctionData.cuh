@@ -1,18 +1,18 @@
 #pragma once
 
-#include "MapSectionCollector.cuh"
+#include "CommunicatorTree.cuh"
 
 struct CellFunctionData
 {
-    MapSectionCollector mapSectionCollector;
+    CommunicatorTree communicatorTree;
 
-    __host__ __inline__ void init(int2 const& universeSize)
+    __host__ __inline__ void init(int2 const& universeSize, int maxCells)
     {
-        mapSectionCollector.init(universeSize, 50);
+        communicatorTree.init(universeSize, maxCells);
     }
 
     __host__ __inline__ void free()
     {
-        mapSectionCollector.free();
+        communicatorTree.free();
     }
 };
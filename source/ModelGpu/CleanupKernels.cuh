@@ -259,6 +259,21 @@ __global__ void cleanupParticleMap(SimulationData data)
     data.particleMap.cleanup_system();
 }
 
+__global__ void cleanupClusterMap(SimulationData data)
+{
+    data.clusterMap.cleanup_system();
+}
+
+__global__ void cleanupOccupancyMap(SimulationData data)
+{
+    data.occupancyMap.cleanup_system();
+}
+
+__global__ void cleanupOccupancyBitmap(SimulationData data)
+{
+    data.occupancyBitmap.cleanup_system();
+}
+
 __global__ void cleanupMetadata(Array<Cluster*> clusterPointers, DynamicMemory strings)
 {
     auto const clusterBlock = calcPartition(clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
@@ -313,6 +328,9 @@ __global__ void cleanupAfterSimulation(SimulationData data)
 {
     KERNEL_CALL(cleanupCellMap, data);  //should be called before cleanupClusters and cleanupCells due to freezing
     KERNEL_CALL(cleanupParticleMap, data);
+    KERNEL_CALL(cleanupClusterMap, data);
+    KERNEL_CALL(cleanupOccupancyMap, data);
+    KERNEL_CALL(cleanupOccupancyBitmap, data);
 
     data.entitiesForCleanup.clusterPointers.reset();
     KERNEL_CALL(cleanupClusterPointers, data.entities.clusterPointers, data.entitiesForCleanup.clusterPointers);
@@ -26,11 +26,17 @@ struct Cluster
     int locked;	//0 = unlocked, 1 = locked
     Cluster* clusterToFuse;
 
+    //bounding circle in ClusterMap, only valid in boundingTimestep
+    float2 boundingCenter;
+    float boundingRadius;
+    int boundingTimestep;
+
     __device__ __inline__ void init()
     {
         _timestepsUntilFreezing = 30;
         _freezed = 0;
         _pointerArrayElement = nullptr;
+        boundingTimestep = -1;
     }
 
     __device__ __inline__ float2& getVelocity()
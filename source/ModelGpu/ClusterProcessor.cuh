@@ -38,6 +38,9 @@ private:
     __inline__ __device__ void destroyCloseCell(float2 const& pos, Cell *cell);
     __inline__ __device__ bool areConnectable(Cell *cell1, Cell *cell2);
 
+    __inline__ __device__ float calcBoundingRadius_block(float2 const& center);
+    __inline__ __device__ bool isCollisionCandidate_block();
+
     __inline__ __device__ void copyClusterWithDecomposition_block();
     __inline__ __device__ void copyClusterWithFusion_block();
     __inline__ __device__ void copyTokenPointers_block(Cluster* sourceCluster, Cluster* targetCluster);
@@ -63,8 +66,15 @@ private:
 /* Implementation                                                       */
 /************************************************************************/
 
+//covers the cell map lookups at +-0.5 around a cell and rounding
+#define BROADPHASE_MARGIN 3.0f
+
  __inline__ __device__ void ClusterProcessor::processingCollision_block()
 {
+    if (!isCollisionCandidate_block()) {
+        return;
+    }
+
     __shared__ Cluster* cluster;
     __shared__ unsigned long long int largestOtherClusterData;
     __shared__ Cluster* clustersArray;
@@ -429,6 +439,49 @@ __inline__ __device__ void ClusterProcessor::processingMovement_block()
 __inline__ __device__ void ClusterProcessor::updateMap_block()
 {
     _data->cellMap.set_block(_cluster->numCellPointers, _cluster->cellPointers);
+    _data->occupancyBitmap.set_block(_cluster->numCellPointers, _cluster->cellPointers);
+
+    auto const radius = calcBoundingRadius_block(_cluster->pos);
+    _data->clusterMap.insert_block(_cluster->pos, radius + BROADPHASE_MARGIN);
+    if (0 == threadIdx.x) {
+        _cluster->boundingCenter = _cluster->pos;
+        _cluster->boundingRadius = radius;
+        _cluster->boundingTimestep = _data->timestep;
+    }
+    __syncthreads();
+}
+
+__inline__ __device__ float ClusterProcessor::calcBoundingRadius_block(float2 const& center)
+{
+    __shared__ int radiusBits;  //non-negative floats are ordered like their bit patterns
+    if (0 == threadIdx.x) {
+        radiusBits = 0;
+    }
+    __syncthreads();
+
+    TorusMetric const metric(_data->size.x, _data->size.y);
+    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
+        auto displacement = _cluster->cellPointers[cellIndex]->absPos - center;
+        metric.correctDisplacement(displacement.x, displacement.y);
+        atomicMax_block(&radiusBits, __float_as_int(Math::length(displacement)));
+    }
+    __syncthreads();
+
+    return __int_as_float(radiusBits);
+}
+
+__inline__ __device__ bool ClusterProcessor::isCollisionCandidate_block()
+{
+    if (_cluster->boundingTimestep != _data->timestep) {
+        return true;
+    }
+
+    //cells may have been added since the cluster was inserted into the cluster map
+    auto const radius = calcBoundingRadius_block(_cluster->boundingCenter);
+    if (radius > _cluster->boundingRadius) {
+        return true;
+    }
+    return _data->clusterMap.isShared_block(_cluster->boundingCenter, _cluster->boundingRadius + BROADPHASE_MARGIN);
 }
 
 __inline__ __device__ void ClusterProcessor::processingRadiation_block()
@@ -209,35 +209,20 @@ __inline__ __device__ void CommunicatorFunction::receiveMessage(Token * token) c
 __inline__ __device__ void CommunicatorFunction::sendMessageToNearbyCommunicators(MessageData const & messageDataToSend, 
     Cell * senderCell, Cell * senderPreviousCell, int & numMessages) const
 { 
-    __shared__ List<Cluster*> clusterList;
-    _data->cellFunctionData.mapSectionCollector.getClusters_block(senderCell->absPos,
-        cudaSimulationParameters.cellFunctionCommunicatorRange, _data->cellMap, &_data->dynamicMemory, clusterList);
-
-    __shared__ Cluster** clusters;
-
     if (0 == threadIdx.x) {
         numMessages = 0;
-        clusters = clusterList.asArray(&_data->dynamicMemory);
     }
     __syncthreads();
 
-    auto const clusterPartition = calcPartition(clusterList.getSize(), threadIdx.x, blockDim.x);
-
-    for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
-        auto const& cluster = clusters[clusterIndex];
-        for (auto cellIndex = 0; cellIndex < cluster->numCellPointers; ++cellIndex) {
-            auto const& cell = cluster->cellPointers[cellIndex];
+    _data->cellFunctionData.communicatorTree.forEachEntryInRange_block(
+        senderCell->absPos, cudaSimulationParameters.cellFunctionCommunicatorRange, [&](Cell* cell) {
             if (cell == senderCell) {
-                continue;
-            }
-            if (Enums::CellFunction::COMMUNICATOR != cell->getCellFunctionType()) {
-                continue;
+                return;
             }
             if (sendMessageToCommunicatorAndReturnSuccess(messageDataToSend, senderCell, senderPreviousCell, cell)) {
                 atomicAdd_block(&numMessages, 1);
             }
-        }
-    }
+        });
 }
 
 __inline__ __device__ bool CommunicatorFunction::sendMessageToCommunicatorAndReturnSuccess(
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <cfloat>
+
+#include "Definitions.cuh"
+
+#include "Base.cuh"
+#include "Array.cuh"
+#include "Cell.cuh"
+
+#include "ModelBasic/TorusMetric.h"
+
+//bounding volume hierarchy over the communicator cells of clusters with tokens, rebuilt each timestep:
+//entries are sorted along a Morton curve of coarse buckets (counting sort) and then grouped level by level with a fixed fan-out
+class CommunicatorTree
+{
+public:
+    struct Entry
+    {
+        Cell* cell;
+        float2 clusterPos;
+    };
+
+    static int const FanOut = 8;
+    static int const MaxLevels = 8;
+
+    __host__ __inline__ void init(int2 const& universeSize, int maxEntries)
+    {
+        _universeSize = universeSize;
+        _bucketsPerAxis = 1;
+        while (_bucketsPerAxis * BucketSize < max(universeSize.x, universeSize.y)) {
+            _bucketsPerAxis *= 2;
+        }
+
+        int maxNodes = 0;
+        int numNodes = maxEntries;
+        for (int level = 0; level < MaxLevels && numNodes > 0 && (numNodes > 1 || 0 == level); ++level) {
+            numNodes = (numNodes + FanOut - 1) / FanOut;
+            maxNodes += numNodes;
+        }
+
+        auto const numBuckets = _bucketsPerAxis * _bucketsPerAxis;
+        _entries.init(maxEntries);
+        CudaMemoryManager::getInstance().acquireMemory<Entry>(maxEntries, _sortedEntries);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBuckets, _bucketStarts);
+        CudaMemoryManager::getInstance().acquireMemory<float4>(maxNodes, _nodeBounds);
+        CudaMemoryManager::getInstance().acquireMemory<Layout>(1, _layout);
+
+        checkCudaErrors(cudaMemset(_bucketStarts, 0, sizeof(int) * numBuckets));
+        checkCudaErrors(cudaMemset(_layout, 0, sizeof(Layout)));
+    }
+
+    __host__ __inline__ void free()
+    {
+        _entries.free();
+        CudaMemoryManager::getInstance().freeMemory(_sortedEntries);
+        CudaMemoryManager::getInstance().freeMemory(_bucketStarts);
+        CudaMemoryManager::getInstance().freeMemory(_nodeBounds);
+        CudaMemoryManager::getInstance().freeMemory(_layout);
+    }
+
+    __device__ __inline__ void reset_system()
+    {
+        auto const partition = calcPartition(
+            _bucketsPerAxis * _bucketsPerAxis, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _bucketStarts[index] = 0;
+        }
+        if (0 == threadIdx.x && 0 == blockIdx.x) {
+            _entries.reset();
+            _layout->numLevels = 0;
+        }
+    }
+
+    __device__ __inline__ void insert(Cell* cell, float2 const& clusterPos)
+    {
+        if (auto entry = _entries.getNewElement()) {
+            *entry = {cell, clusterPos};
+        }
+    }
+
+    //build step 1: count entries per bucket
+    __device__ __inline__ void countBuckets_system()
+    {
+        auto const partition =
+            calcPartition(_entries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            atomicAdd(&_bucketStarts[getBucket(_entries.at(index).clusterPos)], 1);
+        }
+    }
+
+    //build step 2 (single block): exclusive prefix sum of the bucket counts and layout of the levels
+    __device__ __inline__ void calcBucketStarts_block()
+    {
+        __shared__ int threadSums[MaxThreadsPerBlock];
+
+        auto const partition = calcPartition(_bucketsPerAxis * _bucketsPerAxis, threadIdx.x, blockDim.x);
+        int sum = 0;
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            sum += _bucketStarts[index];
+        }
+        threadSums[threadIdx.x] = sum;
+        __syncthreads();
+
+        if (0 == threadIdx.x) {
+            int offset = 0;
+            for (int index = 0; index < blockDim.x; ++index) {
+                auto const threadSum = threadSums[index];
+                threadSums[index] = offset;
+                offset += threadSum;
+            }
+
+            auto& layout = *_layout;
+            layout.numEntries = _entries.getNumEntries();
+            layout.numLevels = 0;
+            int numNodes = layout.numEntries;
+            int levelOffset = 0;
+            while (numNodes > 0 && layout.numLevels < MaxLevels && (numNodes > 1 || 0 == layout.numLevels)) {
+                numNodes = (numNodes + FanOut - 1) / FanOut;
+                layout.levelOffsets[layout.numLevels] = levelOffset;
+                layout.levelSizes[layout.numLevels] = numNodes;
+                levelOffset += numNodes;
+                ++layout.numLevels;
+            }
+        }
+        __syncthreads();
+
+        int offset = threadSums[threadIdx.x];
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const count = _bucketStarts[index];
+            _bucketStarts[index] = offset;
+            offset += count;
+        }
+        __syncthreads();
+    }
+
+    //build step 3: sort entries into their buckets
+    __device__ __inline__ void sortEntries_system()
+    {
+        auto const partition =
+            calcPartition(_entries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& entry = _entries.at(index);
+            auto const sortedIndex = atomicAdd(&_bucketStarts[getBucket(entry.clusterPos)], 1);
+            _sortedEntries[sortedIndex] = entry;
+        }
+    }
+
+    __device__ __inline__ int getNumLevels() const { return _layout->numLevels; }
+
+    //build step 4: bounds of the nodes of one level (from bottom to top)
+    __device__ __inline__ void calcNodeBounds_system(int level)
+    {
+        auto const& layout = *_layout;
+        auto const numNodes = layout.levelSizes[level];
+        auto const numChildren = 0 == level ? layout.numEntries : layout.levelSizes[level - 1];
+        auto const partition = calcPartition(numNodes, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            float4 bounds{FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+            auto const endChildIndex = min((index + 1) * FanOut, numChildren);
+            for (int childIndex = index * FanOut; childIndex < endChildIndex; ++childIndex) {
+                if (0 == level) {
+                    auto const& pos = _sortedEntries[childIndex].clusterPos;
+                    bounds = {min(bounds.x, pos.x), min(bounds.y, pos.y), max(bounds.z, pos.x), max(bounds.w, pos.y)};
+                }
+                else {
+                    auto const& childBounds = _nodeBounds[layout.levelOffsets[level - 1] + childIndex];
+                    bounds = {min(bounds.x, childBounds.x),
+                              min(bounds.y, childBounds.y),
+                              max(bounds.z, childBounds.z),
+                              max(bounds.w, childBounds.w)};
+                }
+            }
+            _nodeBounds[layout.levelOffsets[level] + index] = bounds;
+        }
+    }
+
+    //calls func(Cell*) for all communicator cells whose cluster positions are closer than radius
+    template <typename Func>
+    __device__ __inline__ void forEachEntryInRange_block(float2 const& pos, float radius, Func const& func) const
+    {
+        auto const& layout = *_layout;
+        if (0 == layout.numLevels) {
+            return;
+        }
+
+        //subtrees from the highest level with enough nodes are distributed among the threads
+        int startLevel = 0;
+        for (int level = layout.numLevels - 1; level > 0; --level) {
+            if (layout.levelSizes[level] >= blockDim.x) {
+                startLevel = level;
+                break;
+            }
+        }
+
+        int stackLevels[MaxLevels * FanOut];
+        int stackIndices[MaxLevels * FanOut];
+        auto const partition = calcPartition(layout.levelSizes[startLevel], threadIdx.x, blockDim.x);
+        for (int startIndex = partition.startIndex; startIndex <= partition.endIndex; ++startIndex) {
+            int stackSize = 0;
+            stackLevels[stackSize] = startLevel;
+            stackIndices[stackSize++] = startIndex;
+            while (stackSize > 0) {
+                --stackSize;
+                auto const level = stackLevels[stackSize];
+                auto const index = stackIndices[stackSize];
+                if (!isInRange(_nodeBounds[layout.levelOffsets[level] + index], pos, radius)) {
+                    continue;
+                }
+                auto const numChildren = 0 == level ? layout.numEntries : layout.levelSizes[level - 1];
+                auto const endChildIndex = min((index + 1) * FanOut, numChildren);
+                for (int childIndex = index * FanOut; childIndex < endChildIndex; ++childIndex) {
+                    if (0 == level) {
+                        auto const& entry = _sortedEntries[childIndex];
+                        auto const& entryPos = entry.clusterPos;
+                        if (isInRange(float4{entryPos.x, entryPos.y, entryPos.x, entryPos.y}, pos, radius)) {
+                            func(entry.cell);
+                        }
+                    }
+                    else {
+                        stackLevels[stackSize] = level - 1;
+                        stackIndices[stackSize++] = childIndex;
+                    }
+                }
+            }
+        }
+        __syncthreads();
+    }
+
+private:
+    //torus distance between pos and the box is less than radius
+    __device__ __inline__ bool isInRange(float4 const& bounds, float2 const& pos, float radius) const
+    {
+        auto const halfX = (bounds.z - bounds.x) / 2;
+        auto const halfY = (bounds.w - bounds.y) / 2;
+        auto const distanceX =
+            max(0.0f, abs(TorusMetric::wrapDisplacement(pos.x - bounds.x - halfX, _universeSize.x)) - halfX);
+        auto const distanceY =
+            max(0.0f, abs(TorusMetric::wrapDisplacement(pos.y - bounds.y - halfY, _universeSize.y)) - halfY);
+        return distanceX * distanceX + distanceY * distanceY < radius * radius;
+    }
+
+    __device__ __inline__ int getBucket(float2 const& pos) const
+    {
+        int bucketX = TorusMetric::wrap(floorInt(pos.x), _universeSize.x) / BucketSize;
+        int bucketY = TorusMetric::wrap(floorInt(pos.y), _universeSize.y) / BucketSize;
+
+        //interleave bits of the bucket coordinates
+        int result = 0;
+        for (int bit = 0; (1 << bit) < _bucketsPerAxis; ++bit) {
+            result |= ((bucketX >> bit) & 1) << (2 * bit);
+            result |= ((bucketY >> bit) & 1) << (2 * bit + 1);
+        }
+        return result;
+    }
+
+    static int const BucketSize = 16;
+    static int const MaxThreadsPerBlock = 1024;
+
+    struct Layout
+    {
+        int numEntries;
+        int numLevels;
+        int levelOffsets[MaxLevels];
+        int levelSizes[MaxLevels];
+    };
+
+    int2 _universeSize;
+    int _bucketsPerAxis;
+    Array<Entry> _entries;
+    Entry* _sortedEntries;
+    int* _bucketStarts;
+    float4* _nodeBounds;
+    Layout* _layout;
+};
@@ -1362,10 +1362,16 @@ __inline__ __device__ bool ConstructorFunction::isObstaclePresent_helper(
     HashMap<int2, CellAndNewAbsPos>& tempMap)
 {
     auto const map = _data->cellMap;
+
+    //no cell map lookups needed if the neighborhood is free
+    auto const isNeighborhoodOccupied = _data->occupancyBitmap.isOccupiedNearby(absPos);
+    if (!isNeighborhoodOccupied && ignoreOwnCluster) {
+        return false;
+    }
     for (int dx = -1; dx <= 1; ++dx) {
         for (int dy = -1; dy <= 1; ++dy) {
             float2 const lookupPos = {absPos.x + dx, absPos.y + dy};
-            if (auto otherCell = map.get(lookupPos)) {
+            if (auto otherCell = isNeighborhoodOccupied ? map.get(lookupPos) : nullptr) {
                 if (_cluster != otherCell->cluster) {
                     if (map.mapDistance(otherCell->absPos, absPos) < cudaSimulationParameters.cellMinDistance) {
                         return true;
@@ -22,6 +22,16 @@ public:
 		return _originId;
 	}
 
+	bool isCanceled() const
+	{
+		return _canceled;
+	}
+
+	void cancel()
+	{
+		_canceled = true;
+	}
+
 protected:
 	_CudaJob(string const& originId, bool notifyFinish) : _originId(originId), _notifyFinish(notifyFinish) { }
 	virtual ~_CudaJob() = default;
@@ -29,6 +39,7 @@ protected:
 private:
 	string _originId;
 	bool _notifyFinish = false;
+	bool _canceled = false;
 };
 
 class _ClearDataJob
@@ -97,8 +108,12 @@ public:
     {
         auto imageSize = targetImage->size();
 
+        //rect is not smaller than the image => image is rendered at most at universe resolution
         IntVector2D upperLeft = { std::max(0, rect.p1.x), std::max(0, rect.p1.y) };
-        _rect = { upperLeft, {upperLeft.x + imageSize.width() - 1, upperLeft.y + imageSize.height() - 1 } };
+        IntVector2D lowerRight = {
+            std::max(rect.p2.x, upperLeft.x + imageSize.width() - 1),
+            std::max(rect.p2.y, upperLeft.y + imageSize.height() - 1) };
+        _rect = { upperLeft, lowerRight };
     }
 
     virtual ~_GetImageJob() = default;
@@ -139,17 +154,23 @@ class _GetDataForUpdateJob
 	: public _GetDataJob
 {
 public:
-	_GetDataForUpdateJob(string const& originId, IntRect const& rect, DataAccessTO const& dataTO, DataChangeDescription const& updateDesc)
-		: _GetDataJob(originId, rect, dataTO), _updateDesc(updateDesc) { }
+	_GetDataForUpdateJob(string const& originId, vector<uint64_t> const& ids, DataAccessTO const& dataTO, DataChangeDescription const& updateDesc)
+		: _GetDataJob(originId, IntRect(), dataTO), _ids(ids), _updateDesc(updateDesc) { }
 
 	virtual ~_GetDataForUpdateJob() = default;
 
+	vector<uint64_t> const& getIds() const
+	{
+		return _ids;
+	}
+
 	DataChangeDescription const& getUpdateDescription() const
 	{
 		return _updateDesc;
 	}
 
 private:
+	vector<uint64_t> _ids;
 	DataChangeDescription _updateDesc;
 };
 
@@ -160,8 +181,16 @@ public:
 	_SetDataJob(string const& originId, bool notifyFinish, IntRect const& rect, DataAccessTO const& dataTO)
 		: _CudaJob(originId, notifyFinish), _rect(rect), _dataTO(dataTO) { }
 
+	_SetDataJob(string const& originId, bool notifyFinish, vector<uint64_t> const& ids, DataAccessTO const& dataTO)
+		: _CudaJob(originId, notifyFinish), _ids(ids), _dataTO(dataTO) { }
+
 	virtual ~_SetDataJob() = default;
 
+	optional<vector<uint64_t>> const& getIds() const
+	{
+		return _ids;
+	}
+
 	DataAccessTO getDataTO() const
 	{
 		return _dataTO;
@@ -175,6 +204,7 @@ public:
 private:
 	DataAccessTO _dataTO;
 	IntRect _rect;
+	optional<vector<uint64_t>> _ids;
 };
 
 class _RunSimulationJob
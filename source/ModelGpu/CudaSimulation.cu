@@ -4,6 +4,7 @@
 #include <list>
 #include <iostream>
 #include <functional>
+#include <algorithm>
 
 #include "ModelBasic/SimulationParameters.h"
 #include "Base.cuh"
@@ -86,6 +87,13 @@ CudaSimulation::CudaSimulation(
     CudaMemoryManager::getInstance().acquireMemory<TokenAccessTO>(cudaConstants.MAX_TOKENS, _cudaAccessTO->tokens);
     CudaMemoryManager::getInstance().acquireMemory<char>(cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE, _cudaAccessTO->stringBytes);
 
+    _maxSelectedIds = 1024;  //grows on demand in copySelectedIdsToDevice
+    CudaMemoryManager::getInstance().acquireMemory<uint64_t>(_maxSelectedIds, _cudaSelectedIds);
+
+    checkCudaErrors(cudaStreamCreateWithFlags(&_imageStream, cudaStreamNonBlocking));
+    checkCudaErrors(cudaEventCreateWithFlags(&_imageTransferred, cudaEventDisableTiming));
+    checkCudaErrors(cudaMallocHost(&_imageStagingData, sizeof(unsigned int) * size.x * size.y));
+
     auto const memorySizeAfter = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
 
     std::cout << "[CUDA] " << (memorySizeAfter - memorySizeBefore) / (1024 * 1024) << "mb memory acquired" << std::endl;
@@ -106,6 +114,12 @@ CudaSimulation::~CudaSimulation()
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->particles);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->tokens);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->stringBytes);
+    CudaMemoryManager::getInstance().freeMemory(_cudaSelectedIds);
+
+    checkCudaErrors(cudaStreamSynchronize(_imageStream));
+    checkCudaErrors(cudaFreeHost(_imageStagingData));
+    checkCudaErrors(cudaEventDestroy(_imageTransferred));
+    checkCudaErrors(cudaStreamDestroy(_imageStream));
 
     std::cout << "[CUDA] memory released" << std::endl;
 
@@ -121,33 +135,8 @@ void CudaSimulation::calcCudaTimestep()
     ++_cudaSimulationData->timestep;
 }
 
-void CudaSimulation::DEBUG_printNumEntries()
-{
-    std::cout
-        << "Particles: " << _cudaSimulationData->entities.particles.retrieveNumEntries() << "; "
-        << "Cells: " << _cudaSimulationData->entities.cells.retrieveNumEntries() << "; "
-        << "Clusters: " << _cudaSimulationData->entities.clusters.retrieveNumEntries() << "; "
-        << "CellPointers: " << _cudaSimulationData->entities.cellPointers.retrieveNumEntries() << "; "
-        << "Tokens: " << _cudaSimulationData->entities.tokens.retrieveNumEntries() << "; "
-        << "TokenPointers: " << _cudaSimulationData->entities.tokenPointers.retrieveNumEntries() << "; "
-        << std::endl;
-}
-
-void CudaSimulation::getSimulationImage(int2 const & rectUpperLeft, int2 const & rectLowerRight, unsigned char* imageData)
-{
-    int width = rectLowerRight.x - rectUpperLeft.x + 1;
-    int height = rectLowerRight.y - rectUpperLeft.y + 1;
-    int numPixels = width * height;
-
-    GPU_FUNCTION(drawImage, rectUpperLeft, rectLowerRight, *_cudaSimulationData);
-    checkCudaErrors(cudaMemcpy(
-        imageData, _cudaSimulationData->finalImageData, sizeof(unsigned int) * numPixels, cudaMemcpyDeviceToHost));
-}
-
-void CudaSimulation::getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+void CudaSimulation::copyDataTOtoHost(DataAccessTO const& dataTO)
 {
-    GPU_FUNCTION(getSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, *_cudaAccessTO);
-
     checkCudaErrors(cudaMemcpy(dataTO.numClusters, _cudaAccessTO->numClusters, sizeof(int), cudaMemcpyDeviceToHost));
     checkCudaErrors(cudaMemcpy(dataTO.numCells, _cudaAccessTO->numCells, sizeof(int), cudaMemcpyDeviceToHost));
     checkCudaErrors(cudaMemcpy(dataTO.numParticles, _cudaAccessTO->numParticles, sizeof(int), cudaMemcpyDeviceToHost));
@@ -160,7 +149,7 @@ void CudaSimulation::getSimulationData(int2 const& rectUpperLeft, int2 const& re
     checkCudaErrors(cudaMemcpy(dataTO.stringBytes, _cudaAccessTO->stringBytes, sizeof(char) * (*dataTO.numStringBytes), cudaMemcpyDeviceToHost));
 }
 
-void CudaSimulation::setSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+void CudaSimulation::copyDataTOtoDevice(DataAccessTO const& dataTO)
 {
     checkCudaErrors(cudaMemcpy(_cudaAccessTO->numClusters, dataTO.numClusters, sizeof(int), cudaMemcpyHostToDevice));
     checkCudaErrors(cudaMemcpy(_cudaAccessTO->numCells, dataTO.numCells, sizeof(int), cudaMemcpyHostToDevice));
@@ -172,10 +161,99 @@ void CudaSimulation::setSimulationData(int2 const& rectUpperLeft, int2 const& re
     checkCudaErrors(cudaMemcpy(_cudaAccessTO->particles, dataTO.particles, sizeof(ParticleAccessTO) * (*dataTO.numParticles), cudaMemcpyHostToDevice));
     checkCudaErrors(cudaMemcpy(_cudaAccessTO->tokens, dataTO.tokens, sizeof(TokenAccessTO) * (*dataTO.numTokens), cudaMemcpyHostToDevice));
     checkCudaErrors(cudaMemcpy(_cudaAccessTO->stringBytes, dataTO.stringBytes, sizeof(char) * (*dataTO.numStringBytes), cudaMemcpyHostToDevice));
+}
 
+//returns false if the ids do not fit into the selection buffer
+int CudaSimulation::copySelectedIdsToDevice(std::vector<uint64_t> const& ids)
+{
+    auto sortedIds = ids;
+    std::sort(sortedIds.begin(), sortedIds.end());
+    sortedIds.erase(std::unique(sortedIds.begin(), sortedIds.end()), sortedIds.end());
+
+    int const numIds = static_cast<int>(sortedIds.size());
+    if (numIds > _maxSelectedIds) {
+        CudaMemoryManager::getInstance().freeMemory(_cudaSelectedIds);
+        _maxSelectedIds = numIds * 2;
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(_maxSelectedIds, _cudaSelectedIds);
+    }
+    if (numIds > 0) {
+        checkCudaErrors(cudaMemcpy(_cudaSelectedIds, sortedIds.data(), sizeof(uint64_t) * numIds, cudaMemcpyHostToDevice));
+    }
+    return numIds;
+}
+
+void CudaSimulation::DEBUG_printNumEntries()
+{
+    std::cout
+        << "Particles: " << _cudaSimulationData->entities.particles.retrieveNumEntries() << "; "
+        << "Cells: " << _cudaSimulationData->entities.cells.retrieveNumEntries() << "; "
+        << "Clusters: " << _cudaSimulationData->entities.clusters.retrieveNumEntries() << "; "
+        << "CellPointers: " << _cudaSimulationData->entities.cellPointers.retrieveNumEntries() << "; "
+        << "Tokens: " << _cudaSimulationData->entities.tokens.retrieveNumEntries() << "; "
+        << "TokenPointers: " << _cudaSimulationData->entities.tokenPointers.retrieveNumEntries() << "; "
+        << std::endl;
+}
+
+void CudaSimulation::requestSimulationImage(int2 const& rectUpperLeft, int2 const& rectLowerRight, int2 const& imageSize)
+{
+    if (isSimulationImageRequested()) {
+        checkCudaErrors(cudaStreamSynchronize(_imageStream));
+    }
+
+    _numRequestedPixels = imageSize.x * imageSize.y;
+
+    GPU_FUNCTION(drawImage, rectUpperLeft, rectLowerRight, imageSize, *_cudaSimulationData);
+
+    //finalImageData is not touched by timestep kernels => transfer can run concurrently on a non-blocking stream
+    checkCudaErrors(cudaMemcpyAsync(
+        _imageStagingData,
+        _cudaSimulationData->finalImageData,
+        sizeof(unsigned int) * _numRequestedPixels,
+        cudaMemcpyDeviceToHost,
+        _imageStream));
+    checkCudaErrors(cudaEventRecord(_imageTransferred, _imageStream));
+}
+
+bool CudaSimulation::isSimulationImageRequested() const
+{
+    return _numRequestedPixels > 0;
+}
+
+void CudaSimulation::retrieveRequestedSimulationImage(unsigned char* imageData)
+{
+    checkCudaErrors(cudaEventSynchronize(_imageTransferred));
+    memcpy(imageData, _imageStagingData, sizeof(unsigned int) * _numRequestedPixels);
+    _numRequestedPixels = 0;
+}
+
+void CudaSimulation::getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+{
+    GPU_FUNCTION(getSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, *_cudaAccessTO);
+    copyDataTOtoHost(dataTO);
+}
+
+void CudaSimulation::setSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+{
+    copyDataTOtoDevice(dataTO);
     GPU_FUNCTION(setSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, *_cudaAccessTO);
 }
 
+void CudaSimulation::getSimulationDataByIds(std::vector<uint64_t> const& ids, DataAccessTO const& dataTO)
+{
+    auto const numIds = copySelectedIdsToDevice(ids);
+    IdSelection selection{ _cudaSelectedIds, numIds };
+    GPU_FUNCTION(getSimulationAccessDataByIds, selection, *_cudaSimulationData, *_cudaAccessTO);
+    copyDataTOtoHost(dataTO);
+}
+
+void CudaSimulation::setSimulationDataByIds(std::vector<uint64_t> const& ids, DataAccessTO const& dataTO)
+{
+    auto const numIds = copySelectedIdsToDevice(ids);
+    IdSelection selection{ _cudaSelectedIds, numIds };
+    copyDataTOtoDevice(dataTO);
+    GPU_FUNCTION(setSimulationAccessDataByIds, selection, *_cudaSimulationData, *_cudaAccessTO);
+}
+
 void CudaSimulation::applyForce(ApplyForceData const& applyData)
 {
     CudaApplyForceData cudaApplyData{ applyData.startPos, applyData.endPos, applyData.force, applyData.onlyRotation };
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <vector>
+#include <cuda_runtime.h>
+
 #include "ModelBasic/MonitorData.h"
 #include "ModelBasic/ExecutionParameters.h"
 
@@ -17,10 +20,18 @@ public:
 
     void calcCudaTimestep();
 
-    void getSimulationImage(int2 const& rectUpperLeft, int2 const& rectLowerRight, unsigned char* imageData);
+    //rect is rendered into an image of imageSize (at most the rect size), entities are binned into the downscaled pixels
+    //renders the image and starts its transfer to host asynchronously such that the next timestep can overlap it
+    void requestSimulationImage(int2 const& rectUpperLeft, int2 const& rectLowerRight, int2 const& imageSize);
+    bool isSimulationImageRequested() const;
+    void retrieveRequestedSimulationImage(unsigned char* imageData);
     void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
     void setSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
 
+    //only clusters and particles with given ids are transferred/replaced
+    void getSimulationDataByIds(std::vector<uint64_t> const& ids, DataAccessTO const& dataTO);
+    void setSimulationDataByIds(std::vector<uint64_t> const& ids, DataAccessTO const& dataTO);
+
     struct ApplyForceData
     {
         float2 startPos;
@@ -41,10 +52,20 @@ public:
 
 private:
     void setCudaConstants(CudaConstants const& cudaConstants);
+    void copyDataTOtoHost(DataAccessTO const& dataTO);
+    void copyDataTOtoDevice(DataAccessTO const& dataTO);
+    int copySelectedIdsToDevice(std::vector<uint64_t> const& ids);
     void DEBUG_printNumEntries();
 
 private:
     SimulationData* _cudaSimulationData;
     DataAccessTO* _cudaAccessTO;
     CudaMonitorData* _cudaMonitorData;
+    uint64_t* _cudaSelectedIds;
+    int _maxSelectedIds;
+
+    cudaStream_t _imageStream;
+    cudaEvent_t _imageTransferred;
+    unsigned int* _imageStagingData;   //pinned host memory
+    int _numRequestedPixels = 0;
 };
@@ -38,6 +38,7 @@ void CudaWorker::terminateWorker()
 void CudaWorker::addJob(CudaJob const & job)
 {
 	std::lock_guard<std::mutex> lock(_mutex);
+	removeSupersededJobs(job);
 	_jobs.push_back(job);
 	_condition.notify_all();
 }
@@ -68,7 +69,8 @@ void CudaWorker::run()
 		processJobs();
 
 		if (isSimulationRunning()) {
-			_cudaSimulation->calcCudaTimestep();
+			_cudaSimulation->calcCudaTimestep();   //overlaps with the transfer of a requested image
+			completeImageJob();
 			if (_tpsRestriction) {
 				int remainingTime = 1000000 / (*_tpsRestriction) - timer.nsecsElapsed() / 1000;
 				if (remainingTime > 0) {
@@ -77,6 +79,9 @@ void CudaWorker::run()
 			}
 			Q_EMIT timestepCalculated();
 		}
+		else {
+			completeImageJob();
+		}
 
 		std::unique_lock<std::mutex> uniqueLock(_mutex);
 		if (!_jobs.empty() && !_terminate) {
@@ -96,26 +101,48 @@ void CudaWorker::processJobs()
 	bool notify = false;
 
 	for (auto const& job : _jobs) {
+		if (job->isCanceled()) {
+			if (job->isNotifyFinish()) {
+				notify = true;
+			}
+			continue;
+		}
 
         if (auto _job = boost::dynamic_pointer_cast<_GetImageJob>(job)) {
-            auto rect = _job->getRect();
-            auto image = _job->getTargetImage();
-            auto& mutex = _job->getMutex();
+            if (_pendingImageJob) {
+                //finish the previous image job before its request is replaced
+                transferImage(_pendingImageJob);
+                _finishedJobs.push_back(_pendingImageJob);
+                _pendingImageJob.reset();
+                notify = true;
+            }
 
-            std::lock_guard<std::mutex> lock(mutex);
-            _cudaSimulation->getSimulationImage({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, image->bits());
+            auto rect = _job->getRect();
+            auto const imageSize = _job->getTargetImage()->size();
+            _cudaSimulation->requestSimulationImage(
+                { rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, { imageSize.width(), imageSize.height() });
+            _pendingImageJob = _job;
+            continue;
         }
 
-		if (auto _job = boost::dynamic_pointer_cast<_GetDataJob>(job)) {
+		if (auto _job = boost::dynamic_pointer_cast<_GetDataForUpdateJob>(job)) {
+			_cudaSimulation->getSimulationDataByIds(_job->getIds(), _job->getDataTO());
+		}
+		else if (auto _job = boost::dynamic_pointer_cast<_GetDataJob>(job)) {
 			auto rect = _job->getRect();
 			auto dataTO = _job->getDataTO();
 			_cudaSimulation->getSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
 		}
 
 		if (auto _job = boost::dynamic_pointer_cast<_SetDataJob>(job)) {
-            auto rect = _job->getRect();
 			auto dataTO = _job->getDataTO();
-			_cudaSimulation->setSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
+			if (auto const& ids = _job->getIds()) {
+				_cudaSimulation->setSimulationDataByIds(*ids, dataTO);
+			}
+			else {
+				auto rect = _job->getRect();
+				_cudaSimulation->setSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
+			}
 		}
 
 		if (auto _job = boost::dynamic_pointer_cast<_RunSimulationJob>(job)) {
@@ -172,7 +199,9 @@ void CudaWorker::processJobs()
 		}
 	}
 	if (notify) {
-		_finishedJobs.insert(_finishedJobs.end(), _jobs.begin(), _jobs.end());
+		std::copy_if(_jobs.begin(), _jobs.end(), std::back_inserter(_finishedJobs), [this](CudaJob const& job) {
+			return job != _pendingImageJob;
+		});
 		_jobs.clear();
 		Q_EMIT jobsFinished();
 	}
@@ -181,6 +210,61 @@ void CudaWorker::processJobs()
 	}
 }
 
+void CudaWorker::completeImageJob()
+{
+	if (!_pendingImageJob) {
+		return;
+	}
+	auto const job = _pendingImageJob;
+	_pendingImageJob.reset();
+	transferImage(job);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_finishedJobs.push_back(job);
+	Q_EMIT jobsFinished();
+}
+
+void CudaWorker::transferImage(GetImageJob const& job)
+{
+	//the image is written into a back buffer and afterwards swapped with the target => painting is never blocked
+	auto const target = job->getTargetImage();
+	if (_imageBackBuffer.size() != target->size() || _imageBackBuffer.format() != target->format()) {
+		_imageBackBuffer = QImage(target->size(), target->format());
+	}
+	_cudaSimulation->retrieveRequestedSimulationImage(_imageBackBuffer.bits());
+	{
+		std::lock_guard<std::mutex> lock(job->getMutex());
+		target->swap(_imageBackBuffer);
+	}
+}
+
+void CudaWorker::removeSupersededJobs(CudaJob const& newJob)
+{
+	//only the newest image and monitor request per origin is relevant => older ones are dropped
+	auto isSameKind = [&newJob](CudaJob const& job) {
+		if (job->getOriginId() != newJob->getOriginId()) {
+			return false;
+		}
+		if (boost::dynamic_pointer_cast<_GetImageJob>(newJob)) {
+			return static_cast<bool>(boost::dynamic_pointer_cast<_GetImageJob>(job));
+		}
+		if (boost::dynamic_pointer_cast<_GetMonitorDataJob>(newJob)) {
+			return static_cast<bool>(boost::dynamic_pointer_cast<_GetMonitorDataJob>(job));
+		}
+		return false;
+	};
+	_jobs.erase(std::remove_if(_jobs.begin(), _jobs.end(), isSameKind), _jobs.end());
+
+	//stale data requests own a data TO of the origin => cancel them instead of dropping
+	if (boost::dynamic_pointer_cast<_GetDataForEditJob>(newJob)) {
+		for (auto const& job : _jobs) {
+			if (job->getOriginId() == newJob->getOriginId() && boost::dynamic_pointer_cast<_GetDataForEditJob>(job)) {
+				job->cancel();
+			}
+		}
+	}
+}
+
 bool CudaWorker::isTerminate()
 {
 	std::lock_guard<std::mutex> lock(_mutex);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mutex>
+#include <QImage>
 #include <QThread>
 
 #include "ModelBasic/ChangeDescriptions.h"
@@ -36,6 +37,9 @@ public:
 
 private:
 	void processJobs();
+	void completeImageJob();
+	void transferImage(GetImageJob const& job);
+	void removeSupersededJobs(CudaJob const& newJob);
 	bool isTerminate();
 
 private:
@@ -47,6 +51,9 @@ private:
 	vector<CudaJob> _jobs;
 	vector<CudaJob> _finishedJobs;
 
+	GetImageJob _pendingImageJob;
+	QImage _imageBackBuffer;
+
 	bool _simulationRunning = false;
 	bool _terminate = false;
 	optional<int> _tpsRestriction;
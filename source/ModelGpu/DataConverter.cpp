@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "Base/NumberGenerator.h"
 #include "ModelBasic/Descriptions.h"
 #include "ModelBasic/ChangeDescriptions.h"
@@ -45,35 +47,21 @@ void DataConverter::updateData(DataChangeDescription const & data)
 
 namespace
 {
-    QByteArray convertToQByteArray(char const* data, int size)
-    {
-        QByteArray result;
-        result.reserve(size);
-        for (int i = 0; i < size; ++i) {
-            result[i] = data[i];
-        }
-        return result;
-    }
-
     void convertToArray(QByteArray const& source, char* target, int size)
     {
-        for (int i = 0; i < size; ++i) {
-            if (i < source.size()) {
-                target[i] = source.at(i);
-            }
-            else {
-                target[i] = 0;
-            }
-        }
+        auto const sourceSize = std::min(source.size(), size);
+        memcpy(target, source.constData(), sourceSize);
+        memset(target + sourceSize, 0, size - sourceSize);
     }
 }
 
 DataDescription DataConverter::getDataDescription() const
 {
 	DataDescription result;
-	list<uint64_t> connectingCellIds;
-	unordered_map<int, int> cellIndexByCellTOIndex;
-	unordered_map<int, int> clusterIndexByCellTOIndex;
+	if (*_dataTO.numClusters > 0) {
+		result.clusters = vector<ClusterDescription>();
+		result.clusters->reserve(*_dataTO.numClusters);
+	}
 	for (int i = 0; i < *_dataTO.numClusters; ++i) {
 		ClusterAccessTO const& clusterTO = _dataTO.clusters[i];
 
@@ -84,24 +72,28 @@ DataDescription DataConverter::getDataDescription() const
             metadata.setName(name);
         }
 
-		auto clusterDesc = ClusterDescription().setId(clusterTO.id).setPos({ clusterTO.pos.x, clusterTO.pos.y })
+		result.clusters->emplace_back();
+		auto& clusterDesc = result.clusters->back();
+		clusterDesc.setId(clusterTO.id).setPos({ clusterTO.pos.x, clusterTO.pos.y })
 			.setVel({ clusterTO.vel.x, clusterTO.vel.y })
 			.setAngle(clusterTO.angle)
 			.setAngularVel(clusterTO.angularVel).setMetadata(metadata);
+		if (clusterTO.numCells == 0) {
+			continue;
+		}
+		clusterDesc.cells = vector<CellDescription>(clusterTO.numCells);
 
 		for (int j = 0; j < clusterTO.numCells; ++j) {
 			CellAccessTO const& cellTO = _dataTO.cells[clusterTO.cellStartIndex + j];
-			auto pos = cellTO.pos;
-			auto id = cellTO.id;
-			connectingCellIds.clear();
-			for (int i = 0; i < cellTO.numConnections; ++i) {
-				connectingCellIds.emplace_back(_dataTO.cells[cellTO.connectionIndices[i]].id);
+			auto& cellDesc = clusterDesc.cells->at(j);
+
+			list<uint64_t> connectingCellIds;
+			for (int k = 0; k < cellTO.numConnections; ++k) {
+				connectingCellIds.emplace_back(_dataTO.cells[cellTO.connectionIndices[k]].id);
 			}
-			cellIndexByCellTOIndex.insert_or_assign(clusterTO.cellStartIndex + j, j);
-			clusterIndexByCellTOIndex.insert_or_assign(clusterTO.cellStartIndex + j, i);
 
             auto feature = CellFeatureDescription().setType(static_cast<Enums::CellFunction::Type>(cellTO.cellFunctionType))
-                .setConstData(convertToQByteArray(cellTO.staticData, cellTO.numStaticBytes)).setVolatileData(convertToQByteArray(cellTO.mutableData, cellTO.numMutableBytes));
+                .setConstData(QByteArray(cellTO.staticData, cellTO.numStaticBytes)).setVolatileData(QByteArray(cellTO.mutableData, cellTO.numMutableBytes));
 
             auto const& metadataTO = cellTO.metadata;
             auto metadata = CellMetadata().setColor(metadataTO.color);
@@ -118,41 +110,39 @@ DataDescription DataConverter::getDataDescription() const
                 metadata.setSourceCode(sourceCode);
             }
 
-            clusterDesc.addCell(CellDescription()
-                                    .setPos({pos.x, pos.y})
-                                    .setMetadata(CellMetadata())
-                                    .setEnergy(cellTO.energy)
-                                    .setId(id)
-                                    .setConnectingCells(connectingCellIds)
-                                    .setMaxConnections(cellTO.maxConnections)
-                                    .setTokenBranchNumber(0)
-                                    .setMetadata(metadata)
-                                    .setTokens(vector<TokenDescription>{})
-                                    .setTokenBranchNumber(cellTO.branchNumber)
-                                    .setFlagTokenBlocked(cellTO.tokenBlocked)
-                                    .setTokenUsages(cellTO.tokenUsages)
-                                    .setCellFeature(feature));
+            cellDesc.setPos({ cellTO.pos.x, cellTO.pos.y })
+                .setEnergy(cellTO.energy)
+                .setId(cellTO.id)
+                .setMaxConnections(cellTO.maxConnections)
+                .setMetadata(metadata)
+                .setTokenBranchNumber(cellTO.branchNumber)
+                .setFlagTokenBlocked(cellTO.tokenBlocked)
+                .setTokenUsages(cellTO.tokenUsages)
+                .setCellFeature(feature);
+            cellDesc.connectingCells = std::move(connectingCellIds);
+            cellDesc.tokens = vector<TokenDescription>();
         }
-		result.addCluster(clusterDesc);
+
+		//tokens of a cluster are stored contiguously and refer to cells of the same cluster
+		for (int j = 0; j < clusterTO.numTokens; ++j) {
+			TokenAccessTO const& tokenTO = _dataTO.tokens[clusterTO.tokenStartIndex + j];
+			auto& cellDesc = clusterDesc.cells->at(tokenTO.cellIndex - clusterTO.cellStartIndex);
+			cellDesc.tokens->emplace_back(TokenDescription()
+				.setEnergy(tokenTO.energy)
+				.setData(QByteArray(tokenTO.memory, _parameters.tokenMemorySize)));
+		}
 	}
 
+	if (*_dataTO.numParticles > 0) {
+		result.particles = vector<ParticleDescription>();
+		result.particles->reserve(*_dataTO.numParticles);
+	}
 	for (int i = 0; i < *_dataTO.numParticles; ++i) {
 		ParticleAccessTO const& particle = _dataTO.particles[i];
 		result.addParticle(ParticleDescription().setId(particle.id).setPos({ particle.pos.x, particle.pos.y })
 			.setVel({ particle.vel.x, particle.vel.y }).setEnergy(particle.energy).setMetadata(ParticleMetadata().setColor(particle.metadata.color)));
 	}
 
-	for (int i = 0; i < *_dataTO.numTokens; ++i) {
-		TokenAccessTO const& token = _dataTO.tokens[i];
-		ClusterDescription& cluster = result.clusters->at(clusterIndexByCellTOIndex.at(token.cellIndex));
-		CellDescription& cell = cluster.cells->at(cellIndexByCellTOIndex.at(token.cellIndex));
-		QByteArray data(_parameters.tokenMemorySize, 0);
-		for (int i = 0; i < _parameters.tokenMemorySize; ++i) {
-			data[i] = token.memory[i];
-		}
-		cell.addToken(TokenDescription().setEnergy(token.energy).setData(data));
-	}
-
 	return result;
 }
 
@@ -182,14 +172,11 @@ void DataConverter::addCluster(ClusterDescription const& clusterDesc)
     else {
         clusterTO.metadata.nameLen = 0;
     }
+	clusterTO.cellStartIndex = *_dataTO.numCells;
     unordered_map<uint64_t, int> cellIndexByIds;
-	bool firstIndex = true;
+	cellIndexByIds.reserve(clusterDesc.cells->size());
 	for (CellDescription const& cellDesc : *clusterDesc.cells) {
 		addCell(cellDesc, clusterDesc, clusterTO, cellIndexByIds);
-		if (firstIndex) {
-			clusterTO.cellStartIndex = cellIndexByIds.begin()->second;
-			firstIndex = false;
-		}
 	}
 	for (CellDescription const& cellDesc : *clusterDesc.cells) {
 		if (cellDesc.id != 0) {
@@ -412,11 +399,9 @@ void DataConverter::processModifications()
 int DataConverter::convertStringAndReturnStringIndex(QString const& s)
 {
     auto const result = *_dataTO.numStringBytes;
-    auto const len = s.size();
-    for (int i = 0; i < len; ++i) {
-        _dataTO.stringBytes[result + i] = s.at(i).toLatin1();
-    }
-    (*_dataTO.numStringBytes) += len;
+    auto const bytes = s.toLatin1();
+    memcpy(&_dataTO.stringBytes[result], bytes.constData(), bytes.size());
+    (*_dataTO.numStringBytes) += bytes.size();
     return result;
 }
 
@@ -16,6 +16,9 @@ using CudaJob = boost::shared_ptr<_CudaJob>;
 class _GetDataJob;
 using GetDataJob = boost::shared_ptr<_GetDataJob>;
 
+class _GetImageJob;
+using GetImageJob = boost::shared_ptr<_GetImageJob>;
+
 class _SetDataJob;
 using SetDataJob = boost::shared_ptr<_SetDataJob>;
 
@@ -9,7 +9,7 @@ struct HashFunctor
 template<typename T>
 struct HashFunctor<T*>
 {
-    __device__ __inline__ int operator()(T* const& element)  const
+    __host__ __device__ __inline__ int operator()(T* const& element)  const
     {
         return abs(static_cast<int>(reinterpret_cast<std::uintptr_t>(element)) * 17);
     }
@@ -18,7 +18,7 @@ struct HashFunctor<T*>
 template<>
 struct HashFunctor<int2>
 {
-    __device__ __inline__ int operator()(int2 const& value) const
+    __host__ __device__ __inline__ int operator()(int2 const& value) const
     {
         auto const v1 = abs(value.x);
         int result = abs(value.y) + 0x9e3779b9 + (v1 << 6) + (v1 >> 2);
@@ -4,6 +4,8 @@
 #include "Particle.cuh"
 #include "device_functions.h"
 
+#include "ModelBasic/TorusMetric.h"
+
 class MapInfo
 {
 public:
@@ -11,15 +13,12 @@ public:
 
     __inline__ __host__ __device__ void mapPosCorrection(int2& pos) const
     {
-        pos = {((pos.x % _size.x) + _size.x) % _size.x, ((pos.y % _size.y) + _size.y) % _size.y};
+        TorusMetric(_size.x, _size.y).correctPosition(pos.x, pos.y);
     }
 
     __inline__ __host__ __device__ void mapPosCorrection(float2& pos) const
     {
-        int2 intPart{floorInt(pos.x), floorInt(pos.y)};
-        float2 fracPart = {pos.x - intPart.x, pos.y - intPart.y};
-        mapPosCorrection(intPart);
-        pos = {static_cast<float>(intPart.x) + fracPart.x, static_cast<float>(intPart.y) + fracPart.y};
+        TorusMetric(_size.x, _size.y).correctPosition(pos.x, pos.y);
     }
 
     __inline__ __device__ void mapDisplacementCorrection(float2& disp) const
@@ -196,3 +195,343 @@ public:
         }
     }
 };
+
+//coarse uniform grid counting the bounding circles of clusters per bucket (broadphase for cluster collisions)
+class ClusterMap : public MapInfo
+{
+public:
+    __host__ __inline__ void init(int2 const& size)
+    {
+        MapInfo::init(size);
+        _bucketsSize = {(size.x + BucketSize - 1) / BucketSize, (size.y + BucketSize - 1) / BucketSize};
+        auto const numBuckets = _bucketsSize.x * _bucketsSize.y;
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBuckets, _counts);
+        _bucketEntries.init(numBuckets);
+
+        std::vector<int> hostCounts(numBuckets, 0);
+        checkCudaErrors(cudaMemcpy(_counts, hostCounts.data(), sizeof(int) * numBuckets, cudaMemcpyHostToDevice));
+    }
+
+    __device__ __inline__ void reset() { _bucketEntries.reset(); }
+
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_counts);
+        _bucketEntries.free();
+    }
+
+    __device__ __inline__ void insert_block(float2 const& center, float radius)
+    {
+        forEachBucket_block(center, radius, [&](int bucket) {
+            if (0 == atomicAdd(&_counts[bucket], 1)) {
+                if (auto entry = _bucketEntries.getNewElement()) {
+                    *entry = bucket;
+                }
+            }
+        });
+    }
+
+    //circle needs to be inserted before: returns true if another inserted circle shares a bucket with it
+    __device__ __inline__ bool isShared_block(float2 const& center, float radius) const
+    {
+        __shared__ int result;
+        if (0 == threadIdx.x) {
+            result = 0;
+        }
+        __syncthreads();
+
+        forEachBucket_block(center, radius, [&](int bucket) {
+            if (_counts[bucket] > 1) {
+                result = 1;
+            }
+        });
+        __syncthreads();
+        return 1 == result;
+    }
+
+    __device__ __inline__ void cleanup_system()
+    {
+        auto partition =
+            calcPartition(_bucketEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _counts[_bucketEntries.at(index)] = 0;
+        }
+    }
+
+private:
+    //bucket intervals covering [center - radius, center + radius] on one torus axis
+    __device__ __inline__ int
+    getBucketIntervals(float center, float radius, int size, int numBuckets, int2* intervals) const
+    {
+        int lower = floorInt(center - radius);
+        int const width = floorInt(center + radius) - lower;
+        if (width + 1 >= size) {
+            intervals[0] = {0, numBuckets - 1};
+            return 1;
+        }
+        lower = TorusMetric::wrap(lower, size);
+        int const upper = lower + width;
+        if (upper < size) {
+            intervals[0] = {lower / BucketSize, upper / BucketSize};
+            return 1;
+        }
+        intervals[0] = {lower / BucketSize, numBuckets - 1};
+        intervals[1] = {0, (upper - size) / BucketSize};
+        if (intervals[1].y >= intervals[0].x) {
+            intervals[0] = {0, numBuckets - 1};
+            return 1;
+        }
+        return 2;
+    }
+
+    template <typename Func>
+    __device__ __inline__ void forEachBucket_block(float2 const& center, float radius, Func const& func) const
+    {
+        int2 intervalsX[2];
+        int2 intervalsY[2];
+        auto const numIntervalsX = getBucketIntervals(center.x, radius, _size.x, _bucketsSize.x, intervalsX);
+        auto const numIntervalsY = getBucketIntervals(center.y, radius, _size.y, _bucketsSize.y, intervalsY);
+
+        //rows are distributed among the threads
+        int row = 0;
+        for (int intervalY = 0; intervalY < numIntervalsY; ++intervalY) {
+            for (int bucketY = intervalsY[intervalY].x; bucketY <= intervalsY[intervalY].y; ++bucketY, ++row) {
+                if (row % blockDim.x != threadIdx.x) {
+                    continue;
+                }
+                for (int intervalX = 0; intervalX < numIntervalsX; ++intervalX) {
+                    for (int bucketX = intervalsX[intervalX].x; bucketX <= intervalsX[intervalX].y; ++bucketX) {
+                        func(bucketX + bucketY * _bucketsSize.x);
+                    }
+                }
+            }
+        }
+    }
+
+    static int const BucketSize = 8;
+
+    int2 _bucketsSize;
+    int* _counts;
+    Array<int> _bucketEntries;
+};
+
+//occupancy pyramid with blocks of 4, 16 and 64 units storing the min and max size of the clusters having cells inside
+//allows range queries (e.g. of sensors) to skip free space without scanning the cell map
+class OccupancyMap : public MapInfo
+{
+public:
+    static int const NumLevels = 3;
+
+    __host__ __device__ __inline__ static int getBlockSize(int level) { return 4 << (2 * level); }
+
+    __host__ __inline__ void init(int2 const& size)
+    {
+        MapInfo::init(size);
+        int numBlocks = 0;
+        for (int level = 0; level < NumLevels; ++level) {
+            auto const blockSize = getBlockSize(level);
+            _levelSizes[level] = {(size.x + blockSize - 1) / blockSize, (size.y + blockSize - 1) / blockSize};
+            _levelOffsets[level] = numBlocks;
+            numBlocks += _levelSizes[level].x * _levelSizes[level].y;
+        }
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBlocks, _maxClusterSizes);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numBlocks, _minClusterSizes);
+        _blockEntries.init(numBlocks);
+
+        std::vector<int> hostMaxClusterSizes(numBlocks, 0);
+        std::vector<int> hostMinClusterSizes(numBlocks, FreeMinClusterSize);
+        checkCudaErrors(cudaMemcpy(
+            _maxClusterSizes, hostMaxClusterSizes.data(), sizeof(int) * numBlocks, cudaMemcpyHostToDevice));
+        checkCudaErrors(cudaMemcpy(
+            _minClusterSizes, hostMinClusterSizes.data(), sizeof(int) * numBlocks, cudaMemcpyHostToDevice));
+    }
+
+    __device__ __inline__ void reset() { _blockEntries.reset(); }
+
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_maxClusterSizes);
+        CudaMemoryManager::getInstance().freeMemory(_minClusterSizes);
+        _blockEntries.free();
+    }
+
+    __device__ __inline__ void insert_block(int numCells, Cell** cells, int clusterSize)
+    {
+        auto const partition = calcPartition(numCells, threadIdx.x, blockDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cell = cells[index];
+            int2 posInt = {floorInt(cell->absPos.x), floorInt(cell->absPos.y)};
+            mapPosCorrection(posInt);
+            for (int level = 0; level < NumLevels; ++level) {
+                auto const blockSize = getBlockSize(level);
+                auto const block =
+                    _levelOffsets[level] + posInt.x / blockSize + posInt.y / blockSize * _levelSizes[level].x;
+
+                //cells of a cluster mostly share their blocks => atomic operations only for changing values
+                if (_maxClusterSizes[block] < clusterSize && 0 == atomicMax(&_maxClusterSizes[block], clusterSize)) {
+                    if (auto entry = _blockEntries.getNewElement()) {
+                        *entry = block;
+                    }
+                }
+                if (_minClusterSizes[block] > clusterSize) {
+                    atomicMin(&_minClusterSizes[block], clusterSize);
+                }
+            }
+        }
+        __syncthreads();
+    }
+
+    //returns true if the blocks of given level covering [lowerPos, upperPos] contain no cell of a cluster with size in [minSize, maxSize]
+    __device__ __inline__ bool
+    isFree(int2 const& lowerPos, int2 const& upperPos, int level, int minSize, int maxSize) const
+    {
+        auto const blockSize = getBlockSize(level);
+        for (int y = lowerPos.y; y <= upperPos.y;) {
+            auto const wrappedY = TorusMetric::wrap(y, _size.y);
+            auto const blockY = wrappedY / blockSize;
+            for (int x = lowerPos.x; x <= upperPos.x;) {
+                auto const wrappedX = TorusMetric::wrap(x, _size.x);
+                auto const blockX = wrappedX / blockSize;
+                auto const block = _levelOffsets[level] + blockX + blockY * _levelSizes[level].x;
+                auto const maxClusterSize = _maxClusterSizes[block];
+                if (maxClusterSize > 0 && maxClusterSize >= minSize && _minClusterSizes[block] <= maxSize) {
+                    return false;
+                }
+                x += min((blockX + 1) * blockSize, _size.x) - wrappedX;
+            }
+            y += min((blockY + 1) * blockSize, _size.y) - wrappedY;
+        }
+        return true;
+    }
+
+    //tests from the coarsest to the finest level
+    __device__ __inline__ bool isFree(int2 const& lowerPos, int2 const& upperPos, int minSize, int maxSize) const
+    {
+        for (int level = NumLevels - 1; level >= 0; --level) {
+            if (isFree(lowerPos, upperPos, level, minSize, maxSize)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    __device__ __inline__ void cleanup_system()
+    {
+        auto partition =
+            calcPartition(_blockEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& block = _blockEntries.at(index);
+            _maxClusterSizes[block] = 0;
+            _minClusterSizes[block] = FreeMinClusterSize;
+        }
+    }
+
+private:
+    static int const FreeMinClusterSize = 0x7fffffff;
+
+    int2 _levelSizes[NumLevels];
+    int _levelOffsets[NumLevels];
+    int* _maxClusterSizes;
+    int* _minClusterSizes;
+    Array<int> _blockEntries;
+};
+
+//bit-packed occupancy of the cell map (32 positions per word) with a dilated layer:
+//a dilated bit is set if a cell lies in the 3x3 neighborhood of its position
+class OccupancyBitmap : public MapInfo
+{
+public:
+    __host__ __inline__ void init(int2 const& size)
+    {
+        MapInfo::init(size);
+        _wordsPerRow = (size.x + 31) / 32;
+        auto const numWords = _wordsPerRow * size.y;
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(numWords, _bits);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(numWords, _dilatedBits);
+        checkCudaErrors(cudaMemset(_bits, 0, sizeof(unsigned int) * numWords));
+        checkCudaErrors(cudaMemset(_dilatedBits, 0, sizeof(unsigned int) * numWords));
+    }
+
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_bits);
+        CudaMemoryManager::getInstance().freeMemory(_dilatedBits);
+    }
+
+    __device__ __inline__ void set_block(int numCells, Cell** cells)
+    {
+        auto const partition = calcPartition(numCells, threadIdx.x, blockDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cell = cells[index];
+            int2 posInt = {floorInt(cell->absPos.x), floorInt(cell->absPos.y)};
+            mapPosCorrection(posInt);
+            auto& word = _bits[posInt.x / 32 + posInt.y * _wordsPerRow];
+            auto const bit = 1u << (posInt.x % 32);
+            if (0 == (word & bit)) {
+                atomicOr(&word, bit);
+            }
+        }
+        __syncthreads();
+    }
+
+    //should be called after all cells are set
+    __device__ __inline__ void dilate_system()
+    {
+        auto const partition = calcPartition(
+            _wordsPerRow * _size.y, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const wordX = index % _wordsPerRow;
+            auto const y = index / _wordsPerRow;
+            unsigned int result = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                result |= getHorizontallyDilatedWord(wordX, TorusMetric::wrap(y + dy, _size.y));
+            }
+            _dilatedBits[index] = result;
+        }
+    }
+
+    //returns false if no cell lies in the 3x3 neighborhood of pos
+    __device__ __inline__ bool isOccupiedNearby(float2 const& pos) const
+    {
+        int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
+        mapPosCorrection(posInt);
+        return 0 != (_dilatedBits[posInt.x / 32 + posInt.y * _wordsPerRow] & (1u << (posInt.x % 32)));
+    }
+
+    __device__ __inline__ void cleanup_system()
+    {
+        auto const partition = calcPartition(
+            _wordsPerRow * _size.y, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _bits[index] = 0;
+        }
+    }
+
+private:
+    __device__ __inline__ bool getBit(int x, int y) const
+    {
+        x = TorusMetric::wrap(x, _size.x);
+        return 0 != (_bits[x / 32 + y * _wordsPerRow] & (1u << (x % 32)));
+    }
+
+    __device__ __inline__ unsigned int getHorizontallyDilatedWord(int wordX, int y) const
+    {
+        auto const word = _bits[wordX + y * _wordsPerRow];
+        auto const firstX = wordX * 32;
+        auto const numValidBits = min(32, _size.x - firstX);
+        auto const validBits = 32 == numValidBits ? 0xffffffffu : (1u << numValidBits) - 1;
+
+        auto result = word | (word << 1) | (word >> 1);
+        if (getBit(firstX - 1, y)) {
+            result |= 1u;
+        }
+        if (getBit(firstX + numValidBits, y)) {
+            result |= 1u << (numValidBits - 1);
+        }
+        return result & validBits;
+    }
+
+    int _wordsPerRow;
+    unsigned int* _bits;
+    unsigned int* _dilatedBits;
+};
@@ -20,10 +20,33 @@ __global__ void clearImageMap(unsigned int* imageData, int size)
     }
 }
 
-__device__ __inline__ int mapUniversePosToImageIndex(int2 const& imageSize, int2 const& rectUpperLeft, int2 const& intPos)
+struct ImageSection
 {
-    return (intPos.x - rectUpperLeft.x) + (intPos.y - rectUpperLeft.y) * imageSize.x;
-}
+    int2 rectUpperLeft;
+    int2 rectLowerRight;
+    int2 imageSize;
+
+    __device__ __inline__ bool isDownscaled() const
+    {
+        return imageSize.x <= rectLowerRight.x - rectUpperLeft.x || imageSize.y <= rectLowerRight.y - rectUpperLeft.y;
+    }
+
+    //returns -1 if pos is not visible, without downscaling border pixels are omitted such that neighbors can be drawn
+    __device__ __inline__ int mapUniversePosToImageIndex(int2 const& intPos) const
+    {
+        if (!isContainedInRect(rectUpperLeft, rectLowerRight, intPos)) {
+            return -1;
+        }
+        int2 const imagePos{
+            (intPos.x - rectUpperLeft.x) * imageSize.x / (rectLowerRight.x - rectUpperLeft.x + 1),
+            (intPos.y - rectUpperLeft.y) * imageSize.y / (rectLowerRight.y - rectUpperLeft.y + 1) };
+        if (!isDownscaled()
+            && (imagePos.x < 1 || imagePos.y < 1 || imagePos.x >= imageSize.x - 1 || imagePos.y >= imageSize.y - 1)) {
+            return -1;
+        }
+        return imagePos.x + imagePos.y * imageSize.x;
+    }
+};
 
 __device__ __inline__ unsigned int calcColor(Cell* cell)
 {
@@ -95,11 +118,17 @@ __device__ __inline__ void addingColor(unsigned int& color, unsigned int const&
     color = newColor | 0xff000000;
 }
 
-__device__ __inline__ void drawEntity(unsigned int* imageData, int2 const& imageSize, int const& index, unsigned int color)
+__device__ __inline__ void drawEntity(unsigned int* imageData, ImageSection const& section, int const& index, unsigned int color)
 {
+    auto const& imageSize = section.imageSize;
     color = (color >> 1) & 0x7e7e7e;
     addingColor(imageData[index], color);
 
+    //density binning: entities falling into the same pixel accumulate, the glow is left to the blur pass
+    if (section.isDownscaled()) {
+        return;
+    }
+
     color = (color >> 1) & 0x7e7e7e;
     addingColor(imageData[index - 1], color);
     addingColor(imageData[index + 1], color);
@@ -109,11 +138,9 @@ __device__ __inline__ void drawEntity(unsigned int* imageData, int2 const& image
 
 __global__ void drawClusters(
     int2 universeSize,
-    int2 rectUpperLeft,
-    int2 rectLowerRight,
+    ImageSection section,
     Array<Cluster*> clusters,
-    unsigned int* imageData,
-    int2 imageSize)
+    unsigned int* imageData)
 {
     auto const clusterBlock =
         calcPartition(clusters.getNumEntries(), blockIdx.x, gridDim.x);
@@ -136,10 +163,10 @@ __global__ void drawClusters(
             auto const& cell = cluster->cellPointers[cellIndex];
             auto intPos = toInt2(cell->absPos);
             map.mapPosCorrection(intPos);
-            if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos, 1)) {
-                auto const index = mapUniversePosToImageIndex(imageSize, rectUpperLeft, intPos);
+            auto const index = section.mapUniversePosToImageIndex(intPos);
+            if (index >= 0) {
                 auto const color = calcColor(cell);
-                drawEntity(imageData, imageSize, index, color);
+                drawEntity(imageData, section, index, color);
             }
         }
         __syncthreads();
@@ -150,10 +177,10 @@ __global__ void drawClusters(
             auto const& cell = token->cell;
             auto intPos = toInt2(cell->absPos);
             map.mapPosCorrection(intPos);
-            if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos, 1)) {
-                auto const index = mapUniversePosToImageIndex(imageSize, rectUpperLeft, intPos);
+            auto const index = section.mapUniversePosToImageIndex(intPos);
+            if (index >= 0) {
                 auto const color = calcColor(token);
-                drawEntity(imageData, imageSize, index, color);
+                drawEntity(imageData, section, index, color);
             }
         }
         __syncthreads();
@@ -162,11 +189,9 @@ __global__ void drawClusters(
 
 __global__ void drawParticles(
     int2 universeSize,
-    int2 rectUpperLeft,
-    int2 rectLowerRight,
+    ImageSection section,
     Array<Particle*> particles,
-    unsigned int* imageData,
-    int2 imageSize)
+    unsigned int* imageData)
 {
     auto const particleBlock =
         calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
@@ -174,10 +199,10 @@ __global__ void drawParticles(
     for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
         auto const& particle = particles.at(index);
         auto intPos = toInt2(particle->absPos);
-        if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos, 1)) {
-            auto const index = mapUniversePosToImageIndex(imageSize, rectUpperLeft, intPos);
+        auto const imageIndex = section.mapUniversePosToImageIndex(intPos);
+        if (imageIndex >= 0) {
             auto const color = calcColor(particle);
-            drawEntity(imageData, imageSize, index, color);
+            drawEntity(imageData, section, imageIndex, color);
         }
     }
 }
@@ -236,12 +261,10 @@ __global__ void blurImage(
 /* Main      															*/
 /************************************************************************/
 
-__global__ void drawImage(int2 rectUpperLeft, int2 rectLowerRight, SimulationData data)
+__global__ void drawImage(int2 rectUpperLeft, int2 rectLowerRight, int2 imageSize, SimulationData data)
 {
-    int width = rectLowerRight.x - rectUpperLeft.x + 1;
-    int height = rectLowerRight.y - rectUpperLeft.y + 1;
-    int numPixels = width * height;
-    int2 imageSize{ width, height };
+    int numPixels = imageSize.x * imageSize.y;
+    ImageSection section{ rectUpperLeft, rectLowerRight, imageSize };
 
     unsigned int* targetImage;
     if (cudaExecutionParameters.imageGlow) {
@@ -251,11 +274,11 @@ __global__ void drawImage(int2 rectUpperLeft, int2 rectLowerRight, SimulationDat
         targetImage = data.finalImageData;
     }
     KERNEL_CALL(clearImageMap, targetImage, numPixels);
-    KERNEL_CALL(drawClusters, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterPointers, targetImage, imageSize);
+    KERNEL_CALL(drawClusters, data.size, section, data.entities.clusterPointers, targetImage);
     if (data.entities.clusterFreezedPointers.getNumEntries() > 0) {
-        KERNEL_CALL(drawClusters, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterFreezedPointers, targetImage, imageSize);
+        KERNEL_CALL(drawClusters, data.size, section, data.entities.clusterFreezedPointers, targetImage);
     }
-    KERNEL_CALL(drawParticles, data.size, rectUpperLeft, rectLowerRight, data.entities.particlePointers, targetImage, imageSize);
+    KERNEL_CALL(drawParticles, data.size, section, data.entities.particlePointers, targetImage);
 
     if (cudaExecutionParameters.imageGlow) {
         auto const numBlocks = cudaConstants.NUM_BLOCKS*cudaConstants.NUM_THREADS_PER_BLOCK / 8;
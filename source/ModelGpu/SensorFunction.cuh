@@ -29,6 +29,9 @@ private:
     __device__ __inline__ AngleAndDistance getAngleAndDistance(Cell* cell, Cell* sourceCell, Cell* scanCell) const;
 
 private:
+    static int const VicinityTileLength = 16;  //units per axis of the scan point tiles tested for free space
+    static int const BeamSegmentLength = 8;  //samples per thread along a beam
+
     SimulationData* _data;
     Cluster* _cluster;
 };
@@ -166,46 +169,64 @@ SensorFunction::getNearbyCell(float2 const& pos, int range, int minSize, int max
 {
     __shared__ int stepSize;
     __shared__ int numScanPointsPerAxis;
+    __shared__ int tileSize;
+    __shared__ int numTilesPerAxis;
     __shared__ float distanceToResult;
     __shared__ int resultLock;
     if (0 == threadIdx.x) {
         stepSize = ceil(sqrt(minSize + FP_PRECISION)) + 3;
         numScanPointsPerAxis = (range * 2 + 1) / stepSize;
+        tileSize = max(1, VicinityTileLength / stepSize);
+        numTilesPerAxis = (numScanPointsPerAxis + tileSize - 1) / tileSize;
         result = nullptr;
         distanceToResult = 10000.0;
         resultLock = 0;
     }
     __syncthreads();
 
-    auto const threadPartition = calcPartition(numScanPointsPerAxis * numScanPointsPerAxis, threadIdx.x, blockDim.x);
-    for (int index = threadPartition.startIndex; index <= threadPartition.endIndex; ++index) {
-        int x = index % numScanPointsPerAxis;
-        int y = index / numScanPointsPerAxis;
-        auto const posDelta =
-            float2{static_cast<float>(x * stepSize - range), static_cast<float>(y * stepSize - range)};
-        if (Math::length(posDelta) > range) {
-            continue;
-        }
-        auto const scanCell = _data->cellMap.get(pos + posDelta);
-        if (!scanCell) {
-            continue;
-        }
-        auto const scanCluster = scanCell->cluster;
-        if (_cluster == scanCluster) {
+    int2 const posInt = {floorInt(pos.x), floorInt(pos.y)};
+    auto const threadPartition = calcPartition(numTilesPerAxis * numTilesPerAxis, threadIdx.x, blockDim.x);
+    for (int tileIndex = threadPartition.startIndex; tileIndex <= threadPartition.endIndex; ++tileIndex) {
+        int2 const tileStart = {(tileIndex % numTilesPerAxis) * tileSize, (tileIndex / numTilesPerAxis) * tileSize};
+        int2 const tileEnd = {
+            min(tileStart.x + tileSize, numScanPointsPerAxis) - 1, min(tileStart.y + tileSize, numScanPointsPerAxis) - 1};
+
+        //skip tiles without suitable cells
+        int2 const lowerPos = {posInt.x + tileStart.x * stepSize - range, posInt.y + tileStart.y * stepSize - range};
+        int2 const upperPos = {posInt.x + tileEnd.x * stepSize - range, posInt.y + tileEnd.y * stepSize - range};
+        if (_data->occupancyMap.isFree(lowerPos, upperPos, minSize, maxSize)) {
             continue;
         }
-        auto const scanSize = scanCluster->numCellPointers;
-        if (scanSize >= minSize && scanSize <= maxSize) {
-            auto const distance = _data->cellMap.mapDistance(scanCell->absPos, pos);
-
-            while (1 == atomicExch_block(&resultLock, 1)) {}
-            __threadfence_block();
-            if (!result || (distance < distanceToResult)) {
-                result = scanCell;
-                distanceToResult = distance;
+
+        for (int y = tileStart.y; y <= tileEnd.y; ++y) {
+            for (int x = tileStart.x; x <= tileEnd.x; ++x) {
+                auto const posDelta =
+                    float2{static_cast<float>(x * stepSize - range), static_cast<float>(y * stepSize - range)};
+                if (Math::length(posDelta) > range) {
+                    continue;
+                }
+                auto const scanCell = _data->cellMap.get(pos + posDelta);
+                if (!scanCell) {
+                    continue;
+                }
+                auto const scanCluster = scanCell->cluster;
+                if (_cluster == scanCluster) {
+                    continue;
+                }
+                auto const scanSize = scanCluster->numCellPointers;
+                if (scanSize >= minSize && scanSize <= maxSize) {
+                    auto const distance = _data->cellMap.mapDistance(scanCell->absPos, pos);
+
+                    while (1 == atomicExch_block(&resultLock, 1)) {}
+                    __threadfence_block();
+                    if (!result || (distance < distanceToResult)) {
+                        result = scanCell;
+                        distanceToResult = distance;
+                    }
+                    __threadfence_block();
+                    atomicExch_block(&resultLock, 0);
+                }
             }
-            __threadfence_block();
-            atomicExch_block(&resultLock, 0);
         }
     }
     __syncthreads();
@@ -215,48 +236,79 @@ __device__ __inline__ void
 SensorFunction::getNearbyCellAlongBeam(float2 const& pos, float angle, int minSize, int maxSize, Cell*& result)
 {
     __shared__ float2 direction;
+    __shared__ int numSegments;
 
     __shared__ int hitLock;
     __shared__ bool hit;
     __shared__ int hitDistance;
 
+    auto const numSamples = static_cast<int>(cudaSimulationParameters.cellFunctionSensorRange - 1) / 2;
     if (0 == threadIdx.x) {
         direction = Math::unitVectorOfAngle(angle);
+        numSegments = (numSamples + BeamSegmentLength - 1) / BeamSegmentLength;
         hit = false;
         hitLock = 0;
         result = nullptr;
     }
     __syncthreads();
 
-    auto const threadPartition =
-        calcPartition((cudaSimulationParameters.cellFunctionSensorRange - 1) / 2, threadIdx.x, blockDim.x);
-    for (int index = threadPartition.startIndex; index <= threadPartition.startIndex; ++index) {
-        auto const distance = index * 2 + 1;
-        for (int deltaX = -1; deltaX < 2; ++deltaX) {
-            for (int deltaY = -1; deltaY < 2; ++deltaY) {
-                auto const scanPos =
-                    pos + direction * distance + float2{static_cast<float>(deltaX), static_cast<float>(deltaY)};
-                auto const scanCell = _data->cellMap.get(scanPos);
-                if (!scanCell) {
-                    continue;
-                }
-                if (scanCell->cluster == _cluster) {
-                    continue;
+    //each thread marches along a segment of the beam and skips free space in large strides
+    auto const threadPartition = calcPartition(numSegments, threadIdx.x, blockDim.x);
+    for (int segment = threadPartition.startIndex; segment <= threadPartition.endIndex; ++segment) {
+        auto const endIndex = min((segment + 1) * BeamSegmentLength, numSamples) - 1;
+        for (int index = segment * BeamSegmentLength; index <= endIndex;) {
+            auto const distance = index * 2 + 1;
+            auto const beamPos = pos + direction * distance;
+            int2 const beamPosInt = {floorInt(beamPos.x), floorInt(beamPos.y)};
+
+            //the 3x3 neighborhoods of the next k samples lie within 2k+1 units (+1 for rounding)
+            int numSkippedSamples = 0;
+            for (int level = OccupancyMap::NumLevels - 1; level >= 0; --level) {
+                auto const k = OccupancyMap::getBlockSize(level) / 4;
+                auto const radius = 2 * k + 2;
+                int2 const lowerPos = {beamPosInt.x - radius, beamPosInt.y - radius};
+                int2 const upperPos = {beamPosInt.x + radius, beamPosInt.y + radius};
+                if (_data->occupancyMap.isFree(lowerPos, upperPos, level, minSize, maxSize)) {
+                    numSkippedSamples = k + 1;
+                    break;
                 }
+            }
+            if (numSkippedSamples > 0) {
+                index += numSkippedSamples;
+                continue;
+            }
 
-                auto const massSize = scanCell->cluster->numCellPointers;
-                if (massSize >= minSize && massSize <= maxSize) {
-                    while (1 == atomicExch_block(&hitLock, 1)) {}
-                    __threadfence_block();
-                    if (!hit || distance < hitDistance) {
-                        hit = true;
-                        hitDistance = distance;
-                        result = scanCell;
+            bool hitInSample = false;
+            for (int deltaX = -1; deltaX < 2; ++deltaX) {
+                for (int deltaY = -1; deltaY < 2; ++deltaY) {
+                    auto const scanPos = beamPos + float2{static_cast<float>(deltaX), static_cast<float>(deltaY)};
+                    auto const scanCell = _data->cellMap.get(scanPos);
+                    if (!scanCell) {
+                        continue;
+                    }
+                    if (scanCell->cluster == _cluster) {
+                        continue;
+                    }
+
+                    auto const massSize = scanCell->cluster->numCellPointers;
+                    if (massSize >= minSize && massSize <= maxSize) {
+                        hitInSample = true;
+                        while (1 == atomicExch_block(&hitLock, 1)) {}
+                        __threadfence_block();
+                        if (!hit || distance < hitDistance) {
+                            hit = true;
+                            hitDistance = distance;
+                            result = scanCell;
+                        }
+                        __threadfence_block();
+                        atomicExch_block(&hitLock, 0);
                     }
-                    __threadfence_block();
-                    atomicExch_block(&hitLock, 0);
                 }
             }
+            if (hitInSample) {
+                break;  //further samples of this segment are more distant
+            }
+            ++index;
         }
     }
     __syncthreads();
@@ -33,8 +33,6 @@ void SimulationAccessGpuImpl::init(SimulationControllerGpu* controller)
 	_context = static_cast<SimulationContextGpuImpl*>(controller->getContext());
 	_numberGen = _context->getNumberGenerator();
 	auto worker = _context->getCudaController()->getCudaWorker();
-	auto size = _context->getSpaceProperties()->getSize();
-	_lastDataRect = { { 0,0 }, size };
 	for (auto const& connection : _connections) {
 		QObject::disconnect(connection);
 	}
@@ -49,16 +47,23 @@ void SimulationAccessGpuImpl::clear()
 
 void SimulationAccessGpuImpl::updateData(DataChangeDescription const& updateDesc)
 {
-	auto cudaWorker = _context->getCudaController()->getCudaWorker();
-
-	//heuristic for determining rect
-	auto size = _context->getSpaceProperties()->getSize();
-	IntRect rect = cudaWorker->isSimulationRunning() ? IntRect{ { 0, 0 }, size } : _lastDataRect;
-
 	auto updateDescCorrected = updateDesc;
 	metricCorrection(updateDescCorrected);
 
-	auto job = boost::make_shared<_GetDataForUpdateJob>(getObjectId(), _lastDataRect, _dataTOCache->getDataTO(), updateDescCorrected);
+	//only deleted and modified entities need to be transferred; added ones are created from the description
+	vector<uint64_t> ids;
+	for (auto const& cluster : updateDescCorrected.clusters) {
+		if (cluster.isDeleted() || cluster.isModified()) {
+			ids.emplace_back(cluster->id);
+		}
+	}
+	for (auto const& particle : updateDescCorrected.particles) {
+		if (particle.isDeleted() || particle.isModified()) {
+			ids.emplace_back(particle->id);
+		}
+	}
+
+	auto job = boost::make_shared<_GetDataForUpdateJob>(getObjectId(), ids, _dataTOCache->getDataTO(), updateDescCorrected);
     scheduleJob(job);
     _updateInProgress = true;
 }
@@ -110,9 +115,16 @@ void SimulationAccessGpuImpl::jobsFinished()
 	auto finishedJobs = worker->getFinishedJobs(getObjectId());
 	for (auto const& job : finishedJobs) {
 
+		if (job->isCanceled()) {
+			if (auto const& getDataForEditJob = boost::dynamic_pointer_cast<_GetDataForEditJob>(job)) {
+				_dataTOCache->releaseDataTO(getDataForEditJob->getDataTO());
+			}
+			continue;
+		}
+
 		if (auto const& getDataForUpdateJob = boost::dynamic_pointer_cast<_GetDataForUpdateJob>(job)) {
 			auto dataToUpdateTO = getDataForUpdateJob->getDataTO();
-			updateDataToGpu(dataToUpdateTO, getDataForUpdateJob->getRect(), getDataForUpdateJob->getUpdateDescription());
+			updateDataToGpu(dataToUpdateTO, getDataForUpdateJob->getIds(), getDataForUpdateJob->getUpdateDescription());
 			Q_EMIT dataUpdated();
 		}
 
@@ -122,7 +134,7 @@ void SimulationAccessGpuImpl::jobsFinished()
 
 		if (auto const& getDataForEditJob = boost::dynamic_pointer_cast<_GetDataForEditJob>(job)) {
 			auto dataTO = getDataForEditJob->getDataTO();
-			createDataFromGpuModel(dataTO, getDataForEditJob->getRect());
+			createDataFromGpuModel(dataTO);
 			_dataTOCache->releaseDataTO(dataTO);
 			Q_EMIT dataReadyToRetrieve();
 		}
@@ -138,35 +150,34 @@ void SimulationAccessGpuImpl::jobsFinished()
 	}
 }
 
-void SimulationAccessGpuImpl::updateDataToGpu(DataAccessTO dataToUpdateTO, IntRect const& rect, DataChangeDescription const& updateDesc)
+void SimulationAccessGpuImpl::updateDataToGpu(DataAccessTO dataToUpdateTO, vector<uint64_t> const& ids, DataChangeDescription const& updateDesc)
 {
 	DataConverter converter(dataToUpdateTO, _numberGen, _context->getSimulationParameters());
 	converter.updateData(updateDesc);
 
 	auto cudaWorker = _context->getCudaController()->getCudaWorker();
-	CudaJob job = boost::make_shared<_SetDataJob>(getObjectId(), true, rect, dataToUpdateTO);
+	CudaJob job = boost::make_shared<_SetDataJob>(getObjectId(), true, ids, dataToUpdateTO);
 	cudaWorker->addJob(job);
 }
 
-void SimulationAccessGpuImpl::createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect)
+void SimulationAccessGpuImpl::createDataFromGpuModel(DataAccessTO dataTO)
 {
-	_lastDataRect = rect;
-
 	DataConverter converter(dataTO, _numberGen, _context->getSimulationParameters());
 	_dataCollected = converter.getDataDescription();
 }
 
 void SimulationAccessGpuImpl::metricCorrection(DataChangeDescription & data) const
 {
-	SpaceProperties* space = _context->getSpaceProperties();
+	auto const metric = _context->getSpaceProperties()->getTorusMetric();
 	for (auto& cluster : data.clusters) {
 		QVector2D origPos = cluster->pos.getValue();
 		auto pos = origPos;
-		space->correctPosition(pos);
+		metric.correctPosition(pos);
 		auto correctionDelta = pos - origPos;
-		if (!correctionDelta.isNull()) {
-			cluster->pos.setValue(pos);
+		if (correctionDelta.isNull()) {
+			continue;
 		}
+		cluster->pos.setValue(pos);
 		for (auto& cell : cluster->cells) {
 			cell->pos.setValue(cell->pos.getValue() + correctionDelta);
 		}
@@ -174,7 +185,7 @@ void SimulationAccessGpuImpl::metricCorrection(DataChangeDescription & data) con
 	for (auto& particle : data.particles) {
 		QVector2D origPos = particle->pos.getValue();
 		auto pos = origPos;
-		space->correctPosition(pos);
+		metric.correctPosition(pos);
 		if (pos != origPos) {
 			particle->pos.setValue(pos);
 		}
@@ -27,8 +27,8 @@ private:
     void scheduleJob(CudaJob const& job);
 	Q_SLOT void jobsFinished();
 
-	void updateDataToGpu(DataAccessTO dataToUpdateTO, IntRect const& rect, DataChangeDescription const& updateDesc);
-	void createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect);
+	void updateDataToGpu(DataAccessTO dataToUpdateTO, vector<uint64_t> const& ids, DataChangeDescription const& updateDesc);
+	void createDataFromGpuModel(DataAccessTO dataTO);
 
 	void metricCorrection(DataChangeDescription& data) const;
 
@@ -62,7 +62,6 @@ private:
 
 	DataDescription _dataCollected;
 	DataTOCache _dataTOCache;
-	IntRect _lastDataRect;
 
 	bool _updateInProgress = false;
 	vector<CudaJob> _waitingJobs;
@@ -12,6 +12,9 @@ struct SimulationData
 
     CellMap cellMap;
     ParticleMap particleMap;
+    ClusterMap clusterMap;
+    OccupancyMap occupancyMap;
+    OccupancyBitmap occupancyBitmap;
     CellFunctionData cellFunctionData;
 
     Entities entities;
@@ -30,9 +33,12 @@ struct SimulationData
 
         entities.init(cudaConstants);
         entitiesForCleanup.init(cudaConstants);
-        cellFunctionData.init(universeSize);
+        cellFunctionData.init(universeSize, cudaConstants.MAX_CELLS);
         cellMap.init(size, cudaConstants.MAX_CELLPOINTERS, entities.cellPointers.getArrayForHost());
         particleMap.init(size, cudaConstants.MAX_PARTICLEPOINTERS);
+        clusterMap.init(size);
+        occupancyMap.init(size);
+        occupancyBitmap.init(size);
         dynamicMemory.init(cudaConstants.DYNAMIC_MEMORY_SIZE);
         numberGen.init(40312357);
 
@@ -47,6 +53,9 @@ struct SimulationData
         cellFunctionData.free();
         cellMap.free();
         particleMap.free();
+        clusterMap.free();
+        occupancyMap.free();
+        occupancyBitmap.free();
         numberGen.free();
         dynamicMemory.free();
 
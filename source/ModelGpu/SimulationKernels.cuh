@@ -28,6 +28,11 @@ __global__ void clusterProcessingStep1(SimulationData data, int numClusters)
     }
 }
 
+__global__ void dilateOccupancyBitmap(SimulationData data)
+{
+    data.occupancyBitmap.dilate_system();
+}
+
 __global__ void clusterProcessingStep2(SimulationData data, int numClusters)
 {
     PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
@@ -68,7 +73,38 @@ __global__ void clusterProcessingStep4(SimulationData data, int numClusters)
 /************************************************************************/
 __global__ void resetCellFunctionData(SimulationData data)
 {
-    data.cellFunctionData.mapSectionCollector.reset_system();
+    data.cellFunctionData.communicatorTree.reset_system();
+}
+
+__global__ void countCommunicatorTreeBuckets(SimulationData data)
+{
+    data.cellFunctionData.communicatorTree.countBuckets_system();
+}
+
+__global__ void calcCommunicatorTreeBucketStarts(SimulationData data)
+{
+    data.cellFunctionData.communicatorTree.calcBucketStarts_block();
+}
+
+__global__ void sortCommunicatorTreeEntries(SimulationData data)
+{
+    data.cellFunctionData.communicatorTree.sortEntries_system();
+}
+
+__global__ void calcCommunicatorTreeNodeBounds(SimulationData data, int level)
+{
+    data.cellFunctionData.communicatorTree.calcNodeBounds_system(level);
+}
+
+__device__ void buildCommunicatorTree(SimulationData& data)
+{
+    KERNEL_CALL(countCommunicatorTreeBuckets, data);
+    calcCommunicatorTreeBucketStarts<<<1, cudaConstants.NUM_THREADS_PER_BLOCK>>>(data);
+    cudaDeviceSynchronize();
+    KERNEL_CALL(sortCommunicatorTreeEntries, data);
+    for (int level = 0; level < data.cellFunctionData.communicatorTree.getNumLevels(); ++level) {
+        KERNEL_CALL(calcCommunicatorTreeNodeBounds, data, level);
+    }
 }
 
 __global__ void tokenProcessingStep1(SimulationData data, int numClusters)
@@ -103,6 +139,15 @@ __global__ void tokenProcessingStep3(SimulationData data, int numClusters)
     }
 }
 
+__global__ void updateOccupancyMap(SimulationData data, int numClusters)
+{
+    auto const clusterPartition = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    for (int clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
+        auto const& cluster = data.entities.clusterPointers.at(clusterIndex);
+        data.occupancyMap.insert_block(cluster->numCellPointers, cluster->cellPointers, cluster->numCellPointers);
+    }
+}
+
 __global__ void tokenProcessingStep4(SimulationData data, int numClusters)
 {
     PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
@@ -148,12 +193,17 @@ __global__ void calcSimulationTimestep(SimulationData data)
 {
     data.cellMap.reset();
     data.particleMap.reset();
+    data.clusterMap.reset();
+    data.occupancyMap.reset();
     data.dynamicMemory.reset();
     KERNEL_CALL(resetCellFunctionData, data);
     KERNEL_CALL(clusterProcessingStep1, data, data.entities.clusterPointers.getNumEntries());
+    KERNEL_CALL(dilateOccupancyBitmap, data);
     KERNEL_CALL(tokenProcessingStep1, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(tokenProcessingStep2, data, data.entities.clusterPointers.getNumEntries());
+    buildCommunicatorTree(data);
     KERNEL_CALL(tokenProcessingStep3, data, data.entities.clusterPointers.getNumEntries());
+    KERNEL_CALL(updateOccupancyMap, data, data.entities.clusterPointers.getNumEntries());  //after constructors changed the clusters
     KERNEL_CALL(tokenProcessingStep4, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(clusterProcessingStep2, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(clusterProcessingStep3, data, data.entities.clusterPointers.getNumEntries());
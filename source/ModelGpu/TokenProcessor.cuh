@@ -34,17 +34,54 @@ public:
     __inline__ __device__ void processingCommunicatorsAnsSensors_block();
 
 private:
+    //targets of energy averaging and spreading: own cell of a token followed by its connections
+    static int const TargetsPerToken = MAX_CELL_BONDS + 1;
+    static int const MaxThreadsPerBlock = 1024;
+
+    struct TokenTarget
+    {
+        int cellIndex;  //-1 = no target
+        bool accepted;
+        int numAcceptedTargetsOfCell;
+        float energy;
+    };
+
+    //allocated once for energy averaging and spreading, only tokens with targets get a slot
+    struct TargetData
+    {
+        TokenTarget* targets;   //TargetsPerToken entries per slot, nullptr = not enough dynamic memory
+        int* sortedTargets;     //target indices sorted by cells and slots
+        int* segmentEnds;       //targets of a cell end at segmentEnds[cellIndex] in sortedTargets
+        int* tokenSlots;        //slot of each token, -1 = token without targets
+        int* slotTokens;        //token index of each slot
+        int numSlots;
+    };
+
+    __inline__ __device__ void allocateTargetData_block();
+    __inline__ __device__ void initTargetData_block();
+    __inline__ __device__ void addTarget(int slot, int targetIndex, Cell* cell, float energy);
+    __inline__ __device__ void sortAndAcceptTargets_block();
+    __inline__ __device__ int getSegmentStart(int cellIndex);
+    __inline__ __device__ int calcThreadOffset_block(int threadSum, int& blockSum);
+    __inline__ __device__ bool hasTargets(Token const* token);
+    __inline__ __device__ bool isSpreadingTarget(int tokenBranchNumber, Cell const* connectingCell);
+
+    //fallback if the target data does not fit into the dynamic memory
+    __inline__ __device__ void processingEnergyAveragingWithLocks_block();
+    __inline__ __device__ void processingSpreadingWithLocks_block();
+    __inline__ __device__ void resetTags_block();
+
     __inline__ __device__ void calcAnticipatedTokens(Cluster* cluster, int& result);
     __inline__ __device__ void copyToken(Token const* sourceToken, Token* targetToken, Cell* targetCell);
     __inline__ __device__ void moveToken(Token* sourceToken, Token*& targetToken, Cell* targetCell, Cell* dummy);
 
-    __inline__ __device__ void resetTags_block();
-
 private:
     SimulationData* _data;
     Cluster* _cluster;
     PartitionData _cellPartition;
     PartitionData _tokenPartition;
+    TargetData _targetData;
+    bool _targetDataAllocated;
 };
 
 /************************************************************************/
@@ -56,76 +93,89 @@ __inline__ __device__ void TokenProcessor::init_block(SimulationData& data, int
     _cluster = data.entities.clusterPointers.at(clusterIndex);
     _cellPartition = calcPartition(_cluster->numCellPointers, threadIdx.x, blockDim.x);
     _tokenPartition = calcPartition(_cluster->numTokenPointers, threadIdx.x, blockDim.x);
+    _targetDataAllocated = false;
 }
 
 __inline__ __device__ void TokenProcessor::processingEnergyAveraging_block()
 {
-    auto& cluster = _cluster;
-    if (0 == cluster->numTokenPointers) {
+    if (0 == _cluster->numTokenPointers) {
         return;
     }
 
-    __shared__ BlockLock clusterLock;
-    clusterLock.init_block();
-
-    resetTags_block();
+    allocateTargetData_block();
+    if (nullptr == _targetData.targets) {
+        processingEnergyAveragingWithLocks_block();
+        return;
+    }
+    initTargetData_block();
 
-    Cell* candidateCellsForEnergyAveraging[MAX_CELL_BONDS + 1];
-    Cell* cellsForEnergyAveraging[MAX_CELL_BONDS + 1];
+    //phase 1: cells for energy averaging of each token
     for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
-        auto const& token = cluster->tokenPointers[tokenIndex];
-        auto& cell = token->cell;
-        if (token->getEnergy() < cudaSimulationParameters.tokenMinEnergy) {
+        auto const slot = _targetData.tokenSlots[tokenIndex];
+        if (-1 == slot) {
             continue;
         }
 
-        int tokenBranchNumber = token->getTokenBranchNumber();
-        int numCandidateCellsForEnergyAveraging = 1;
-        candidateCellsForEnergyAveraging[0] = cell;
+        auto const& token = _cluster->tokenPointers[tokenIndex];
+        auto const& cell = token->cell;
+        auto const tokenBranchNumber = token->getTokenBranchNumber();
+        addTarget(slot, 0, cell, 0);
         for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
-            auto& connectingCell = *cell->connections[connectionIndex];
-            if (0 == connectingCell.alive) {
-                continue;
-            }
-            if (((tokenBranchNumber + 1 - connectingCell.branchNumber)
-                % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
-                continue;
-            }
-            if (connectingCell.tokenBlocked) {
-                continue;
-            }
-            int numToken = atomicAdd(&connectingCell.tag, 1);
-            if (numToken >= cudaSimulationParameters.cellMaxToken) {
-                continue;
+            auto const& connectingCell = cell->connections[connectionIndex];
+            if (isSpreadingTarget(tokenBranchNumber, connectingCell)) {
+                addTarget(slot, connectionIndex + 1, connectingCell, 0);
             }
-            candidateCellsForEnergyAveraging[numCandidateCellsForEnergyAveraging++] = &connectingCell;
         }
+    }
+    __syncthreads();
 
+    sortAndAcceptTargets_block();
+
+    //phase 2: energy changes of each token, weighted such that the total energy is conserved
+    //even if a cell is averaged by several tokens
+    auto const slotPartition = calcPartition(_targetData.numSlots, threadIdx.x, blockDim.x);
+    for (auto slot = slotPartition.startIndex; slot <= slotPartition.endIndex; ++slot) {
+        auto const targets = &_targetData.targets[slot * TargetsPerToken];
         float averageEnergy = 0;
         int numCellsForEnergyAveraging = 0;
-
-        clusterLock.getLock();
-        for (int index = 0; index < numCandidateCellsForEnergyAveraging; ++index) {
-            auto const& cell = candidateCellsForEnergyAveraging[index];
-            cell->getLock();
+        int maxNumAcceptedTargetsOfCell = 0;
+        for (int targetIndex = 0; targetIndex < TargetsPerToken; ++targetIndex) {
+            auto const& target = targets[targetIndex];
+            if (target.accepted) {
+                averageEnergy += _cluster->cellPointers[target.cellIndex]->getEnergy();
+                ++numCellsForEnergyAveraging;
+                maxNumAcceptedTargetsOfCell = max(maxNumAcceptedTargetsOfCell, target.numAcceptedTargetsOfCell);
+            }
         }
-        clusterLock.releaseLock();
-
-        for (int index = 0; index < numCandidateCellsForEnergyAveraging; ++index) {
-            auto const& cell = candidateCellsForEnergyAveraging[index];
-            averageEnergy += cell->getEnergy_safe();
-            cellsForEnergyAveraging[numCellsForEnergyAveraging++] = cell;
+        if (0 == numCellsForEnergyAveraging) {
+            continue;
         }
         averageEnergy /= numCellsForEnergyAveraging;
-        for (int index = 0; index < numCellsForEnergyAveraging; ++index) {
-            auto const& cell = cellsForEnergyAveraging[index];
-            cell->setEnergy_safe(averageEnergy);
+        for (int targetIndex = 0; targetIndex < TargetsPerToken; ++targetIndex) {
+            auto& target = targets[targetIndex];
+            if (target.accepted) {
+                auto const cellEnergy = _cluster->cellPointers[target.cellIndex]->getEnergy();
+                target.energy = (averageEnergy - cellEnergy) / maxNumAcceptedTargetsOfCell;
+            }
         }
+    }
+    __syncthreads();
 
-        for (int index = 0; index < numCandidateCellsForEnergyAveraging; ++index) {
-            auto const& cell = candidateCellsForEnergyAveraging[index];
-            cell->releaseLock();
+    //phase 3: segmented sum of the energy changes of each cell
+    for (auto cellIndex = _cellPartition.startIndex; cellIndex <= _cellPartition.endIndex; ++cellIndex) {
+        auto const segmentStart = getSegmentStart(cellIndex);
+        auto const segmentEnd = _targetData.segmentEnds[cellIndex];
+        if (segmentStart == segmentEnd) {
+            continue;
+        }
+        float energyChange = 0;
+        for (int index = segmentStart; index < segmentEnd; ++index) {
+            auto const& target = _targetData.targets[_targetData.sortedTargets[index]];
+            if (target.accepted) {
+                energyChange += target.energy;
+            }
         }
+        _cluster->cellPointers[cellIndex]->changeEnergy_safe(energyChange);
     }
     __syncthreads();
 }
@@ -136,14 +186,16 @@ __inline__ __device__ void TokenProcessor::processingSpreading_block()
         return;
     }
 
+    allocateTargetData_block();
+    if (nullptr == _targetData.targets) {
+        processingSpreadingWithLocks_block();
+        return;
+    }
+    initTargetData_block();
+
     __shared__ int anticipatedTokens;
     calcAnticipatedTokens(_cluster, anticipatedTokens);
 
-    __shared__ BlockLock clusterLock;
-    clusterLock.init_block();
-
-    resetTags_block();
-
     __shared__ int newNumTokens;
     __shared__ Token** newTokenPointers;
     if (0 == threadIdx.x) {
@@ -152,73 +204,108 @@ __inline__ __device__ void TokenProcessor::processingSpreading_block()
     }
     __syncthreads();
 
+    //phase 1: target cells of each token with their shared energy, own cell receives the remaining energy
     for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
-        auto& token = _cluster->tokenPointers[tokenIndex];
-
-        auto cell = token->cell;
-        if (0 == cell->alive || token->getEnergy() < cudaSimulationParameters.tokenMinEnergy) {
-            cell->getLock();
-            cell->changeEnergy_safe(token->getEnergy());
-            cell->releaseLock();
+        auto const& token = _cluster->tokenPointers[tokenIndex];
+        auto const& cell = token->cell;
+        auto const tokenEnergy = token->getEnergy();
+        auto const slot = _targetData.tokenSlots[tokenIndex];
+        if (-1 == slot) {
+            cell->changeEnergy_safe(tokenEnergy);
             continue;
         }
 
         auto const tokenBranchNumber = token->getTokenBranchNumber();
 
         int numFreePlaces = 0;
-        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
-            auto const& connectingCell = cell->connections[connectionIndex];
-            if (0 == connectingCell->alive) {
-                continue;
-            }
-            if (((tokenBranchNumber + 1 - connectingCell->branchNumber)
-                % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
-                continue;
-            }
-            if (connectingCell->tokenBlocked) {
-                continue;
+        if (1 == cell->alive) {
+            for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
+                if (isSpreadingTarget(tokenBranchNumber, cell->connections[connectionIndex])) {
+                    ++numFreePlaces;
+                }
             }
-            ++numFreePlaces;
         }
 
+        addTarget(slot, 0, cell, 0);
         if (0 == numFreePlaces) {
-            cell->getLock();
-            cell->changeEnergy_safe(token->getEnergy());
-            cell->releaseLock();
             continue;
         }
-
-        clusterLock.getLock();
-        cell->getLock();
+        auto const sharedEnergyFromPrevToken = tokenEnergy / numFreePlaces;
         for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
             auto const& connectingCell = cell->connections[connectionIndex];
-            connectingCell->getLock();
+            if (isSpreadingTarget(tokenBranchNumber, connectingCell)) {
+                addTarget(slot, connectionIndex + 1, connectingCell, sharedEnergyFromPrevToken);
+            }
         }
-        clusterLock.releaseLock();
+    }
+    __syncthreads();
 
-        auto const tokenEnergy = token->getEnergy();
-        auto const sharedEnergyFromPrevToken = tokenEnergy / numFreePlaces;
-        auto remainingTokenEnergyForCell = tokenEnergy;
-        auto tokenRecycled = false;
-        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
-            auto const& connectingCell = cell->connections[connectionIndex];
-            if (0 == connectingCell->alive) {
-                continue;
+    sortAndAcceptTargets_block();
+
+    //phase 2: remaining token energy for the own cell
+    auto const slotPartition = calcPartition(_targetData.numSlots, threadIdx.x, blockDim.x);
+    for (auto slot = slotPartition.startIndex; slot <= slotPartition.endIndex; ++slot) {
+        auto const targets = &_targetData.targets[slot * TargetsPerToken];
+        auto remainingTokenEnergyForCell = _cluster->tokenPointers[_targetData.slotTokens[slot]]->getEnergy();
+        for (int targetIndex = 1; targetIndex < TargetsPerToken; ++targetIndex) {
+            auto const& target = targets[targetIndex];
+            if (target.accepted) {
+                remainingTokenEnergyForCell -= target.energy;
             }
-            if (((tokenBranchNumber + 1 - connectingCell->branchNumber)
-                % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
+        }
+        targets[0].energy = max(0.0f, remainingTokenEnergyForCell);
+    }
+    __syncthreads();
+
+    //phase 3: energy balance of each cell in token order, new tokens take their full energy from the cell if possible
+    for (auto cellIndex = _cellPartition.startIndex; cellIndex <= _cellPartition.endIndex; ++cellIndex) {
+        auto const segmentStart = getSegmentStart(cellIndex);
+        auto const segmentEnd = _targetData.segmentEnds[cellIndex];
+        if (segmentStart == segmentEnd) {
+            continue;
+        }
+        auto const& cell = _cluster->cellPointers[cellIndex];
+        auto cellEnergy = cell->getEnergy();
+        for (int index = segmentStart; index < segmentEnd; ++index) {
+            auto const targetIndex = _targetData.sortedTargets[index];
+            auto& target = _targetData.targets[targetIndex];
+            if (!target.accepted) {
                 continue;
             }
-            if (connectingCell->tokenBlocked) {
+            if (0 == targetIndex % TargetsPerToken) {
+                cellEnergy += target.energy;
                 continue;
             }
-            
-            int numToken = atomicAdd_block(&connectingCell->tag, 1);
-            if (numToken >= cudaSimulationParameters.cellMaxToken) {
+            auto const tokenIndex = _targetData.slotTokens[targetIndex / TargetsPerToken];
+            auto const tokenEnergy = _cluster->tokenPointers[tokenIndex]->getEnergy();
+            auto const energyFromCell = tokenEnergy - target.energy;
+            if (cellEnergy > cudaSimulationParameters.cellMinEnergy + energyFromCell) {
+                cellEnergy -= energyFromCell;
+                target.energy = tokenEnergy;
+            }
+        }
+        cell->setEnergy_safe(cellEnergy);
+    }
+    __syncthreads();
+
+    //phase 4: new tokens on accepted target cells
+    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+        auto const slot = _targetData.tokenSlots[tokenIndex];
+        if (-1 == slot) {
+            continue;
+        }
+        auto& token = _cluster->tokenPointers[tokenIndex];
+        auto const targets = &_targetData.targets[slot * TargetsPerToken];
+        auto const cell = token->cell;
+        auto tokenRecycled = false;
+        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
+            auto const& target = targets[connectionIndex + 1];
+            if (!target.accepted) {
                 continue;
             }
 
-            int tokenIndex = atomicAdd_block(&newNumTokens, 1);
+            auto const& connectingCell = cell->connections[connectionIndex];
+            int newTokenIndex = atomicAdd_block(&newNumTokens, 1);
             Token* newToken;
             atomicAdd_block(&connectingCell->tokenUsages, 1);
             if (!tokenRecycled) {
@@ -229,25 +316,8 @@ __inline__ __device__ void TokenProcessor::processingSpreading_block()
                 newToken = _data->entities.tokens.getNewElement();
                 copyToken(token, newToken, connectingCell);
             }
-            newTokenPointers[tokenIndex] = newToken;
-
-            if (connectingCell->getEnergy_safe() > cudaSimulationParameters.cellMinEnergy + tokenEnergy - sharedEnergyFromPrevToken) {
-                newToken->setEnergy(tokenEnergy);
-                connectingCell->changeEnergy_safe(-(tokenEnergy - sharedEnergyFromPrevToken));
-            }
-            else {
-                newToken->setEnergy(sharedEnergyFromPrevToken);
-            }
-            remainingTokenEnergyForCell -= sharedEnergyFromPrevToken;
-        }
-        if (remainingTokenEnergyForCell > 0) {
-            cell->changeEnergy_safe(remainingTokenEnergyForCell);
-        }
-
-        cell->releaseLock();
-        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
-            auto const& connectingCell = cell->connections[connectionIndex];
-            connectingCell->releaseLock();
+            newTokenPointers[newTokenIndex] = newToken;
+            newToken->setEnergy(target.energy);
         }
     }
     __syncthreads();
@@ -353,28 +423,197 @@ __inline__ __device__ void TokenProcessor::processingCommunicatorsAnsSensors_blo
 
 __inline__ __device__ void TokenProcessor::createCellFunctionData_block()
 {
-    auto const cellPartition = calcPartition(_cluster->numCellPointers, threadIdx.x, blockDim.x);
-    __shared__ bool hasToken;
-    __shared__ bool hasCommunicator;
-    if (0 == threadIdx.x) {
-        hasToken = _cluster->numTokenPointers > 0;
-        hasCommunicator = false;
+    if (0 == _cluster->numTokenPointers) {
+        return;
     }
-    __syncthreads();
 
+    auto const cellPartition = calcPartition(_cluster->numCellPointers, threadIdx.x, blockDim.x);
     for (int cellIndex = cellPartition.startIndex; cellIndex <= cellPartition.endIndex; ++cellIndex) {
         auto const& cell = _cluster->cellPointers[cellIndex];
         if (Enums::CellFunction::COMMUNICATOR == cell->getCellFunctionType()) {
-            hasCommunicator = true;
+            _data->cellFunctionData.communicatorTree.insert(cell, _cluster->pos);
         }
     }
     __syncthreads();
+}
+
+__inline__ __device__ void TokenProcessor::allocateTargetData_block()
+{
+    if (_targetDataAllocated) {
+        return;
+    }
+    _targetDataAllocated = true;
+
+    int numTokensWithTargets = 0;
+    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+        if (hasTargets(_cluster->tokenPointers[tokenIndex])) {
+            ++numTokensWithTargets;
+        }
+    }
+    int numSlots;
+    auto slot = calcThreadOffset_block(numTokensWithTargets, numSlots);
+
+    __shared__ TargetData targetData;
+    if (0 == threadIdx.x) {
+        auto const numTargets = numSlots * TargetsPerToken;
+        targetData.targets = _data->dynamicMemory.getArray<TokenTarget>(numTargets);
+        targetData.sortedTargets = _data->dynamicMemory.getArray<int>(numTargets);
+        targetData.segmentEnds = _data->dynamicMemory.getArray<int>(_cluster->numCellPointers);
+        targetData.tokenSlots = _data->dynamicMemory.getArray<int>(_cluster->numTokenPointers);
+        targetData.slotTokens = _data->dynamicMemory.getArray<int>(numSlots);
+        targetData.numSlots = numSlots;
+        if (nullptr == targetData.sortedTargets || nullptr == targetData.segmentEnds
+            || nullptr == targetData.tokenSlots || nullptr == targetData.slotTokens) {
+            targetData.targets = nullptr;
+        }
+    }
+    __syncthreads();
+
+    _targetData = targetData;
+    __syncthreads();
+
+    if (nullptr == _targetData.targets) {
+        return;
+    }
+    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+        if (hasTargets(_cluster->tokenPointers[tokenIndex])) {
+            _targetData.tokenSlots[tokenIndex] = slot;
+            _targetData.slotTokens[slot] = tokenIndex;
+            ++slot;
+        }
+        else {
+            _targetData.tokenSlots[tokenIndex] = -1;
+        }
+    }
+    __syncthreads();
+}
+
+__inline__ __device__ void TokenProcessor::initTargetData_block()
+{
+    auto const targetPartition = calcPartition(_targetData.numSlots * TargetsPerToken, threadIdx.x, blockDim.x);
+    for (int targetIndex = targetPartition.startIndex; targetIndex <= targetPartition.endIndex; ++targetIndex) {
+        _targetData.targets[targetIndex] = {-1, false, 0, 0};
+    }
+    for (auto cellIndex = _cellPartition.startIndex; cellIndex <= _cellPartition.endIndex; ++cellIndex) {
+        _cluster->cellPointers[cellIndex]->tag = cellIndex;
+        _targetData.segmentEnds[cellIndex] = 0;
+    }
+    __syncthreads();
+}
+
+__inline__ __device__ void TokenProcessor::addTarget(int slot, int targetIndex, Cell* cell, float energy)
+{
+    auto& target = _targetData.targets[slot * TargetsPerToken + targetIndex];
+    target.cellIndex = cell->tag;
+    target.energy = energy;
+    atomicAdd_block(&_targetData.segmentEnds[cell->tag], 1);
+}
+
+//counting sort of the targets by cells, afterwards targets of each cell are ordered by slots (and thus by tokens)
+//and the first cellMaxToken targets from connections are accepted (own cells are always accepted)
+__inline__ __device__ void TokenProcessor::sortAndAcceptTargets_block()
+{
+    int sum = 0;
+    for (auto cellIndex = _cellPartition.startIndex; cellIndex <= _cellPartition.endIndex; ++cellIndex) {
+        sum += _targetData.segmentEnds[cellIndex];
+    }
+    int numTargets;
+    int offset = calcThreadOffset_block(sum, numTargets);
+
+    //segmentEnds contain the segment starts until the targets are inserted
+    for (auto cellIndex = _cellPartition.startIndex; cellIndex <= _cellPartition.endIndex; ++cellIndex) {
+        auto const count = _targetData.segmentEnds[cellIndex];
+        _targetData.segmentEnds[cellIndex] = offset;
+        offset += count;
+    }
+    __syncthreads();
+
+    auto const targetPartition = calcPartition(_targetData.numSlots * TargetsPerToken, threadIdx.x, blockDim.x);
+    for (int targetIndex = targetPartition.startIndex; targetIndex <= targetPartition.endIndex; ++targetIndex) {
+        auto const cellIndex = _targetData.targets[targetIndex].cellIndex;
+        if (-1 != cellIndex) {
+            _targetData.sortedTargets[atomicAdd_block(&_targetData.segmentEnds[cellIndex], 1)] = targetIndex;
+        }
+    }
+    __syncthreads();
+
+    for (auto cellIndex = _cellPartition.startIndex; cellIndex <= _cellPartition.endIndex; ++cellIndex) {
+        auto const segmentStart = getSegmentStart(cellIndex);
+        auto const segmentEnd = _targetData.segmentEnds[cellIndex];
+        auto const sortedTargets = _targetData.sortedTargets;
+        for (int index = segmentStart + 1; index < segmentEnd; ++index) {
+            auto const targetIndex = sortedTargets[index];
+            int insertIndex = index;
+            for (; insertIndex > segmentStart && sortedTargets[insertIndex - 1] > targetIndex; --insertIndex) {
+                sortedTargets[insertIndex] = sortedTargets[insertIndex - 1];
+            }
+            sortedTargets[insertIndex] = targetIndex;
+        }
+
+        int numTokensFromConnections = 0;
+        int numAcceptedTargets = 0;
+        for (int index = segmentStart; index < segmentEnd; ++index) {
+            auto& target = _targetData.targets[sortedTargets[index]];
+            target.accepted = 0 == sortedTargets[index] % TargetsPerToken
+                || numTokensFromConnections++ < cudaSimulationParameters.cellMaxToken;
+            if (target.accepted) {
+                ++numAcceptedTargets;
+            }
+        }
+        for (int index = segmentStart; index < segmentEnd; ++index) {
+            _targetData.targets[sortedTargets[index]].numAcceptedTargetsOfCell = numAcceptedTargets;
+        }
+    }
+    __syncthreads();
+}
+
+__inline__ __device__ int TokenProcessor::getSegmentStart(int cellIndex)
+{
+    return 0 == cellIndex ? 0 : _targetData.segmentEnds[cellIndex - 1];
+}
+
+//exclusive prefix sum of the thread sums in the block
+__inline__ __device__ int TokenProcessor::calcThreadOffset_block(int threadSum, int& blockSum)
+{
+    __shared__ int threadSums[MaxThreadsPerBlock];
+    __shared__ int totalSum;
+
+    threadSums[threadIdx.x] = threadSum;
+    __syncthreads();
 
     if (0 == threadIdx.x) {
-        if (hasToken && hasCommunicator) {
-            _data->cellFunctionData.mapSectionCollector.insert(_cluster, &_data->dynamicMemory);
+        int offset = 0;
+        for (int index = 0; index < blockDim.x; ++index) {
+            auto const sum = threadSums[index];
+            threadSums[index] = offset;
+            offset += sum;
         }
+        totalSum = offset;
+    }
+    __syncthreads();
+
+    auto const result = threadSums[threadIdx.x];
+    blockSum = totalSum;
+    __syncthreads();
+
+    return result;
+}
+
+__inline__ __device__ bool TokenProcessor::hasTargets(Token const* token)
+{
+    return token->getEnergy() >= cudaSimulationParameters.tokenMinEnergy;
+}
+
+__inline__ __device__ bool TokenProcessor::isSpreadingTarget(int tokenBranchNumber, Cell const* connectingCell)
+{
+    if (0 == connectingCell->alive) {
+        return false;
+    }
+    if (((tokenBranchNumber + 1 - connectingCell->branchNumber)
+        % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
+        return false;
     }
+    return !connectingCell->tokenBlocked;
 }
 
 __inline__ __device__ void TokenProcessor::calcAnticipatedTokens(Cluster* cluster, int& result)
@@ -394,18 +633,9 @@ __inline__ __device__ void TokenProcessor::calcAnticipatedTokens(Cluster* cluste
 
         auto const tokenBranchNumber = token->getTokenBranchNumber();
         for (auto connectionIndex = 0; connectionIndex < cell.numConnections; ++connectionIndex) {
-            auto const& connectingCell = cell.connections[connectionIndex];
-            if (0 == connectingCell->alive) {
-                continue;
-            }
-            if (((tokenBranchNumber + 1 - connectingCell->branchNumber)
-                % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
-                continue;
-            }
-            if (connectingCell->tokenBlocked) {
-                continue;
+            if (isSpreadingTarget(tokenBranchNumber, cell.connections[connectionIndex])) {
+                atomicAdd_block(&result, 1);
             }
-            atomicAdd_block(&result, 1);
         }
     }
     __syncthreads();
@@ -438,20 +668,200 @@ __inline__ __device__ void TokenProcessor::calcAnticipatedTokens(Cluster* cluste
 */
 }
 
-__inline__ __device__ void TokenProcessor::copyToken(Token const* sourceToken, Token* targetToken, Cell* targetCell)
+__inline__ __device__ void TokenProcessor::processingEnergyAveragingWithLocks_block()
 {
-    *targetToken = *sourceToken;
-    targetToken->memory[0] = targetCell->branchNumber;
-    targetToken->sourceCell = sourceToken->cell;
-    targetToken->cell = targetCell;
+    auto& cluster = _cluster;
+
+    __shared__ BlockLock clusterLock;
+    clusterLock.init_block();
+
+    resetTags_block();
+
+    Cell* candidateCellsForEnergyAveraging[MAX_CELL_BONDS + 1];
+    Cell* cellsForEnergyAveraging[MAX_CELL_BONDS + 1];
+    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+        auto const& token = cluster->tokenPointers[tokenIndex];
+        auto& cell = token->cell;
+        if (token->getEnergy() < cudaSimulationParameters.tokenMinEnergy) {
+            continue;
+        }
+
+        int tokenBranchNumber = token->getTokenBranchNumber();
+        int numCandidateCellsForEnergyAveraging = 1;
+        candidateCellsForEnergyAveraging[0] = cell;
+        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
+            auto& connectingCell = *cell->connections[connectionIndex];
+            if (0 == connectingCell.alive) {
+                continue;
+            }
+            if (((tokenBranchNumber + 1 - connectingCell.branchNumber)
+                % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
+                continue;
+            }
+            if (connectingCell.tokenBlocked) {
+                continue;
+            }
+            int numToken = atomicAdd(&connectingCell.tag, 1);
+            if (numToken >= cudaSimulationParameters.cellMaxToken) {
+                continue;
+            }
+            candidateCellsForEnergyAveraging[numCandidateCellsForEnergyAveraging++] = &connectingCell;
+        }
+
+        float averageEnergy = 0;
+        int numCellsForEnergyAveraging = 0;
+
+        clusterLock.getLock();
+        for (int index = 0; index < numCandidateCellsForEnergyAveraging; ++index) {
+            auto const& cell = candidateCellsForEnergyAveraging[index];
+            cell->getLock();
+        }
+        clusterLock.releaseLock();
+
+        for (int index = 0; index < numCandidateCellsForEnergyAveraging; ++index) {
+            auto const& cell = candidateCellsForEnergyAveraging[index];
+            averageEnergy += cell->getEnergy_safe();
+            cellsForEnergyAveraging[numCellsForEnergyAveraging++] = cell;
+        }
+        averageEnergy /= numCellsForEnergyAveraging;
+        for (int index = 0; index < numCellsForEnergyAveraging; ++index) {
+            auto const& cell = cellsForEnergyAveraging[index];
+            cell->setEnergy_safe(averageEnergy);
+        }
+
+        for (int index = 0; index < numCandidateCellsForEnergyAveraging; ++index) {
+            auto const& cell = candidateCellsForEnergyAveraging[index];
+            cell->releaseLock();
+        }
+    }
+    __syncthreads();
 }
 
-__inline__ __device__ void TokenProcessor::moveToken(Token* sourceToken, Token*& targetToken, Cell* targetCell, Cell* dummy)
+__inline__ __device__ void TokenProcessor::processingSpreadingWithLocks_block()
 {
-    targetToken = sourceToken;
-    targetToken->memory[0] = targetCell->branchNumber;
-    targetToken->sourceCell = sourceToken->cell;
-    targetToken->cell = targetCell;
+    __shared__ int anticipatedTokens;
+    calcAnticipatedTokens(_cluster, anticipatedTokens);
+
+    __shared__ BlockLock clusterLock;
+    clusterLock.init_block();
+
+    resetTags_block();
+
+    __shared__ int newNumTokens;
+    __shared__ Token** newTokenPointers;
+    if (0 == threadIdx.x) {
+        newNumTokens = 0;
+        newTokenPointers = _data->entities.tokenPointers.getNewSubarray(anticipatedTokens);
+    }
+    __syncthreads();
+
+    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+        auto& token = _cluster->tokenPointers[tokenIndex];
+
+        auto cell = token->cell;
+        if (0 == cell->alive || token->getEnergy() < cudaSimulationParameters.tokenMinEnergy) {
+            cell->getLock();
+            cell->changeEnergy_safe(token->getEnergy());
+            cell->releaseLock();
+            continue;
+        }
+
+        auto const tokenBranchNumber = token->getTokenBranchNumber();
+
+        int numFreePlaces = 0;
+        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
+            auto const& connectingCell = cell->connections[connectionIndex];
+            if (0 == connectingCell->alive) {
+                continue;
+            }
+            if (((tokenBranchNumber + 1 - connectingCell->branchNumber)
+                % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
+                continue;
+            }
+            if (connectingCell->tokenBlocked) {
+                continue;
+            }
+            ++numFreePlaces;
+        }
+
+        if (0 == numFreePlaces) {
+            cell->getLock();
+            cell->changeEnergy_safe(token->getEnergy());
+            cell->releaseLock();
+            continue;
+        }
+
+        clusterLock.getLock();
+        cell->getLock();
+        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
+            auto const& connectingCell = cell->connections[connectionIndex];
+            connectingCell->getLock();
+        }
+        clusterLock.releaseLock();
+
+        auto const tokenEnergy = token->getEnergy();
+        auto const sharedEnergyFromPrevToken = tokenEnergy / numFreePlaces;
+        auto remainingTokenEnergyForCell = tokenEnergy;
+        auto tokenRecycled = false;
+        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
+            auto const& connectingCell = cell->connections[connectionIndex];
+            if (0 == connectingCell->alive) {
+                continue;
+            }
+            if (((tokenBranchNumber + 1 - connectingCell->branchNumber)
+                % cudaSimulationParameters.cellMaxTokenBranchNumber) != 0) {
+                continue;
+            }
+            if (connectingCell->tokenBlocked) {
+                continue;
+            }
+            
+            int numToken = atomicAdd_block(&connectingCell->tag, 1);
+            if (numToken >= cudaSimulationParameters.cellMaxToken) {
+                continue;
+            }
+
+            int tokenIndex = atomicAdd_block(&newNumTokens, 1);
+            Token* newToken;
+            atomicAdd_block(&connectingCell->tokenUsages, 1);
+            if (!tokenRecycled) {
+                moveToken(token, newToken, connectingCell, cell);
+                tokenRecycled = true;
+            }
+            else {
+                newToken = _data->entities.tokens.getNewElement();
+                copyToken(token, newToken, connectingCell);
+            }
+            newTokenPointers[tokenIndex] = newToken;
+
+            if (connectingCell->getEnergy_safe() > cudaSimulationParameters.cellMinEnergy + tokenEnergy - sharedEnergyFromPrevToken) {
+                newToken->setEnergy(tokenEnergy);
+                connectingCell->changeEnergy_safe(-(tokenEnergy - sharedEnergyFromPrevToken));
+            }
+            else {
+                newToken->setEnergy(sharedEnergyFromPrevToken);
+            }
+            remainingTokenEnergyForCell -= sharedEnergyFromPrevToken;
+        }
+        if (remainingTokenEnergyForCell > 0) {
+            cell->changeEnergy_safe(remainingTokenEnergyForCell);
+        }
+
+        cell->releaseLock();
+        for (int connectionIndex = 0; connectionIndex < cell->numConnections; ++connectionIndex) {
+            auto const& connectingCell = cell->connections[connectionIndex];
+            connectingCell->releaseLock();
+        }
+    }
+    __syncthreads();
+
+    if (0 == threadIdx.x) {
+        _cluster->tokenPointers = newTokenPointers;
+        _cluster->numTokenPointers = newNumTokens;
+    }
+    __syncthreads();
+
+    _tokenPartition = calcPartition(_cluster->numTokenPointers, threadIdx.x, blockDim.x);
 }
 
 __inline__ __device__ void TokenProcessor::resetTags_block()
@@ -464,3 +874,19 @@ __inline__ __device__ void TokenProcessor::resetTags_block()
     }
     __syncthreads();
 }
+
+__inline__ __device__ void TokenProcessor::copyToken(Token const* sourceToken, Token* targetToken, Cell* targetCell)
+{
+    *targetToken = *sourceToken;
+    targetToken->memory[0] = targetCell->branchNumber;
+    targetToken->sourceCell = sourceToken->cell;
+    targetToken->cell = targetCell;
+}
+
+__inline__ __device__ void TokenProcessor::moveToken(Token* sourceToken, Token*& targetToken, Cell* targetCell, Cell* dummy)
+{
+    targetToken = sourceToken;
+    targetToken->memory[0] = targetCell->branchNumber;
+    targetToken->sourceCell = sourceToken->cell;
+    targetToken->cell = targetCell;
+}
@@ -1,5 +1,6 @@
 #include "Base/ServiceLocator.h"
 #include "ModelBasic/CellComputerCompiler.h"
+#include "ModelBasic/CellComputerMachine.h"
 
 #include "IntegrationGpuTestFramework.h"
 
@@ -487,3 +488,84 @@ TEST_F(CellComputerGpuTests, testDivisionByZero)
     auto data = runSimpleCellComputer(program);
     EXPECT_EQ(0, data.at(1));  
 }
+
+/**
+* Situation: batch compilation of repeated sources using a symbol, symbol is changed afterwards
+* Expected result: results equal those of the resolved sources and are recompiled after the symbol change
+*/
+TEST_F(CellComputerGpuTests, testCompileSourceCodes)
+{
+    auto basicFacade = ServiceLocator::getInstance().getService<ModelBasicBuilderFacade>();
+    auto symbolTable = _context->getSymbolTable();
+    symbolTable->addEntry("TEST_VAR", "[1]");
+    CellComputerCompiler* compiler = basicFacade->buildCellComputerCompiler(symbolTable, _context->getSimulationParameters());
+
+    vector<string> programs;
+    for (int i = 0; i < 100; ++i) {
+        programs.emplace_back("mov TEST_VAR, " + std::to_string(i % 10));
+    }
+    programs.emplace_back("mov [1], ");
+    auto const results = compiler->compileSourceCodes(programs);
+
+    ASSERT_EQ(programs.size(), results.size());
+    for (int i = 0; i < 100; ++i) {
+        auto const expectedResult = compiler->compileSourceCode("mov [1], " + std::to_string(i % 10));
+        EXPECT_TRUE(results[i].compilationOk);
+        EXPECT_EQ(expectedResult.compilation, results[i].compilation);
+    }
+    EXPECT_FALSE(results.back().compilationOk);
+
+    symbolTable->addEntry("TEST_VAR", "[2]");
+    auto const expectedResult = compiler->compileSourceCode("mov [2], 0");
+    EXPECT_EQ(expectedResult.compilation, compiler->compileSourceCode(programs.front()).compilation);
+}
+
+/**
+* Situation: programs are executed on device and by the host-side cell computer
+* Expected result: resulting token memories are equal
+*/
+TEST_F(CellComputerGpuTests, testHostMachine)
+{
+    vector<string> programs = {
+        "mov [1], 3\n"\
+        "mov [[1]], 5",
+        "mov [1], 7\n"\
+        "mov [2], 3\n"\
+        "div [1], [2]\n"\
+        "sub [2], 10\n"\
+        "mul [3], [2]",
+        "mov [1], 5\n"\
+        "if [1] > 3\n"\
+        "mov [2], 1\n"\
+        "if [1] < 3\n"\
+        "mov [3], 1\n"\
+        "else\n"\
+        "mov [3], 2\n"\
+        "endif\n"\
+        "else\n"\
+        "mov [2], 2\n"\
+        "endif",
+        "mov [1], 100\n"\
+        "add [1], 100\n"\
+        "if [1] > 3\n"\
+        "div [2], 0\n"\
+        "endif"
+    };
+
+    auto basicFacade = ServiceLocator::getInstance().getService<ModelBasicBuilderFacade>();
+    CellComputerCompiler* compiler = basicFacade->buildCellComputerCompiler(_context->getSymbolTable(), _context->getSimulationParameters());
+    CellComputerMachine machine(_context->getSimulationParameters());
+
+    uint64_t cellId = 0;
+    for (auto const& program : programs) {
+        auto const deviceData = runSimpleCellComputer(program);
+
+        auto const code = compiler->compileSourceCode(program).compilation;
+        QByteArray hostData(_parameters.tokenMemorySize, 0);
+        QByteArray cellMemory(_parameters.cellFunctionComputerCellMemorySize, 0);
+        machine.execute({ { ++cellId, &code, hostData.data(), cellMemory.data() } });
+
+        //first byte contains branch number
+        EXPECT_EQ(deviceData.mid(1), hostData.mid(1));
+    }
+}
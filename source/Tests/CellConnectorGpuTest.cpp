@@ -344,3 +344,18 @@ TEST_F(CellConnectorGpuTest, testMoveSeveralCellsOverOtherCells)
 	ASSERT_TRUE(clusterConsistsOfFollowingCells(cluster3, { cellIds[15], cellIds[16], cellIds[17], cellIds[18], cellIds[19] }));
 
 }
+
+TEST_F(CellConnectorGpuTest, testMoveOneCellAwayFromLargeCluster)
+{
+	_data.addCluster(createRectangularCluster({ 400, 250 }, QVector2D{ 300, 150 }, QVector2D{}));
+	auto& movedCell = _data.clusters->at(0).cells->at(0);
+	auto const movedCellId = movedCell.id;
+	movedCell.pos = *movedCell.pos + QVector2D{ -10, -10 };
+
+	_descHelper->reconnect(_data, _data, { movedCellId });
+
+	_navi.update(_data);
+	auto const& movedCellCluster = _data.clusters->at(_navi.clusterIndicesByCellIds.at(movedCellId));
+	ASSERT_EQ(2, _data.clusters->size());
+	ASSERT_EQ(1, movedCellCluster.cells->size());
+}
@@ -110,3 +110,71 @@ TEST_F(ChangeDescriptionsTest, testCreateClusterChangeDescriptionFromClusterDesc
 	ASSERT_EQ(newEnergyCell1, *cell1.energy);
 	ASSERT_EQ(maxConnectionsCell4, *cell4.maxConnections);
 }
+
+TEST_F(ChangeDescriptionsTest, testCreateDataChangeDescriptionWithEdits)
+{
+	DataDescription data1;
+	for (uint64_t id = 1; id <= 100; ++id) {
+		data1.addCluster(ClusterDescription().setId(id).setPos({ static_cast<float>(id), 0 }).setVel({ 0, 0 }).setAngle(0).setAngularVel(0)
+			.addCell(CellDescription().setId(1000 + id).setPos({ static_cast<float>(id), 0 }).setEnergy(100)));
+		data1.addParticle(ParticleDescription().setId(2000 + id).setPos({ static_cast<float>(id), 1 }).setEnergy(10));
+	}
+
+	DataDescription data2 = data1;
+	DescriptionEdits edits;
+	data2.clusters->at(10).cells->at(0).energy = 150.0;
+	edits.markClusterEdited(11);
+	edits.markClusterEdited(31);	//edited without changing its content
+	data2.clusters->erase(data2.clusters->begin() + 20);
+	edits.markClusterEdited(21);
+	data2.particles->at(5).energy = 20.0;
+	edits.markParticleEdited(2006);
+	data2.addCluster(ClusterDescription().setId(500).setPos({ 0, 0 }).setVel({ 0, 0 }).setAngle(0).setAngularVel(0)
+		.addCell(CellDescription().setId(501).setPos({ 0, 0 }).setEnergy(100)));
+	edits.markClusterEdited(500);
+	data2.clusters->at(50).cells->at(0).energy = 120.0;	//not marked => not compared
+
+	DescriptionNavigator navi1;
+	DescriptionNavigator navi2;
+	navi1.update(data1);
+	navi2.update(data2);
+	DataChangeDescription change(data1, navi1, data2, navi2, edits);
+
+	ASSERT_EQ(3, change.clusters.size());
+	ASSERT_TRUE(change.clusters.at(0).isModified());
+	ASSERT_EQ(11, change.clusters.at(0)->id);
+	ASSERT_TRUE(change.clusters.at(1).isDeleted());
+	ASSERT_EQ(21, change.clusters.at(1)->id);
+	ASSERT_TRUE(change.clusters.at(2).isAdded());
+	ASSERT_EQ(500, change.clusters.at(2)->id);
+	ASSERT_EQ(1, change.particles.size());
+	ASSERT_TRUE(change.particles.at(0).isModified());
+	ASSERT_EQ(2006, change.particles.at(0)->id);
+}
+
+TEST_F(ChangeDescriptionsTest, testCreateDataChangeDescriptionWithAllEdited)
+{
+	DataDescription data1;
+	for (uint64_t id = 1; id <= 10; ++id) {
+		data1.addCluster(ClusterDescription().setId(id).setPos({ static_cast<float>(id), 0 }).setVel({ 0, 0 }).setAngle(0).setAngularVel(0)
+			.addCell(CellDescription().setId(1000 + id).setPos({ static_cast<float>(id), 0 }).setEnergy(100)));
+	}
+
+	DataDescription data2 = data1;
+	data2.clusters->at(3).cells->at(0).energy = 150.0;
+	data2.clusters->at(7).pos = QVector2D(5, 5);
+	DescriptionEdits edits;
+	edits.markAllEdited();
+
+	DescriptionNavigator navi1;
+	DescriptionNavigator navi2;
+	navi1.update(data1);
+	navi2.update(data2);
+	DataChangeDescription change(data1, navi1, data2, navi2, edits);
+	DataChangeDescription expectedChange(data1, data2);
+
+	ASSERT_EQ(2, change.clusters.size());
+	ASSERT_EQ(expectedChange.clusters.size(), change.clusters.size());
+	ASSERT_EQ(4, change.clusters.at(0)->id);
+	ASSERT_EQ(8, change.clusters.at(1)->id);
+}
@@ -297,6 +297,39 @@ TEST_F(CommunicatorGpuTests, testOneSenderAndTwoReceivers_oneOutOfRange)
              CommunicatorResult().numMessagesSent(0).messageReceived(Enums::CommunicatorOutReceivedNewMessage::NO)}));
 }
 
+TEST_F(CommunicatorGpuTests, testOneSenderAndManyReceivers)
+{
+    auto const withinComRange = _parameters.cellFunctionCommunicatorRange - 20;
+    auto const outOfComRange = _parameters.cellFunctionCommunicatorRange + 50;
+    vector<Communicator> communicators{Communicator()
+                                           .pos({0, 0})
+                                           .command(Enums::CommunicatorIn::SEND_MESSAGE)
+                                           .cellIndexWithToken(1)
+                                           .sendingMessage(123)};
+    vector<CommunicatorResult> results{
+        CommunicatorResult().numMessagesSent(8).messageReceived(Enums::CommunicatorOutReceivedNewMessage::NO)};
+    vector<QVector2D> const directions{{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {0.7f, 0.7f}, {-0.7f, 0.7f}, {0.7f, -0.7f}, {-0.7f, -0.7f}};
+    for (auto const& direction : directions) {
+        communicators.emplace_back(Communicator()
+                                       .pos(direction * withinComRange)
+                                       .command(Enums::CommunicatorIn::RECEIVE_MESSAGE)
+                                       .cellIndexWithToken(0));
+        results.emplace_back(CommunicatorResult()
+                                 .numMessagesSent(0)
+                                 .messageReceived(Enums::CommunicatorOutReceivedNewMessage::YES)
+                                 .message(123));
+    }
+    for (int i = 0; i < 4; ++i) {
+        communicators.emplace_back(Communicator()
+                                       .pos(directions.at(i) * outOfComRange)
+                                       .command(Enums::CommunicatorIn::RECEIVE_MESSAGE)
+                                       .cellIndexWithToken(0));
+        results.emplace_back(
+            CommunicatorResult().numMessagesSent(0).messageReceived(Enums::CommunicatorOutReceivedNewMessage::NO));
+    }
+    runStandardTest(TestParameters().communicators(communicators), Expectations().communicatorResult(results));
+}
+
 TEST_F(CommunicatorGpuTests, testOneSenderAndTwoReceivers_oneHasWrongChannel)
 {
     auto const withinComRange = _parameters.cellFunctionCommunicatorRange - 10;
@@ -427,3 +427,88 @@ TEST_F(DataDescriptionTransferGpuTests, regressionTestRepeatingPartialUpdateAndR
         }
     }
 }
+
+/**
+* Situation:
+* 	- two clusters and one particle
+*   - only one cluster is moved and the particle is deleted
+* Expected result: only edited entities are affected, the other cluster is unchanged
+*/
+TEST_F(DataDescriptionTransferGpuTests, testUpdateOnlyEditedEntities)
+{
+    DataDescription origData;
+    origData.addCluster(createHorizontalCluster(2, QVector2D{ 10, 10 }, QVector2D{}, 0));
+    origData.addCluster(createHorizontalCluster(2, QVector2D{ 50, 10 }, QVector2D{}, 0));
+    origData.addParticle(createParticle(QVector2D{ 100, 100 }, QVector2D{}));
+    IntegrationTestHelper::updateData(_access, origData);
+
+    auto const data = IntegrationTestHelper::getContent(_access, { { 0, 0 },{ _universeSize.x, _universeSize.y } });
+    auto changedData = data;
+    auto const unchangedCluster = changedData.clusters->at(1);
+    setCenterPos(changedData.clusters->at(0), QVector2D{ 20, 20 });
+    changedData.particles->clear();
+    IntegrationTestHelper::updateData(_access, DataChangeDescription(data, changedData));
+
+    DataDescription newData = IntegrationTestHelper::getContent(_access, { { 0, 0 },{ _universeSize.x, _universeSize.y } });
+    ASSERT_EQ(2, newData.clusters->size());
+    EXPECT_TRUE(!newData.particles || newData.particles->empty());
+
+    auto const clusterByClusterId = IntegrationTestHelper::getClusterByClusterId(newData);
+    EXPECT_TRUE(checkCompatibility(unchangedCluster, clusterByClusterId.at(unchangedCluster.id)));
+    EXPECT_TRUE(checkCompatibility(changedData.clusters->at(0), clusterByClusterId.at(changedData.clusters->at(0).id)));
+}
+
+/**
+* Situation:
+* 	- many particles
+*   - all particles are moved in one update (more ids than the initial id selection buffer holds)
+* Expected result: all particles are moved
+*/
+TEST_F(DataDescriptionTransferGpuTests, testUpdateManyEditedEntities)
+{
+    DataDescription origData;
+    for (int i = 0; i < 3000; ++i) {
+        origData.addParticle(createParticle(QVector2D(i % 500, i / 500), QVector2D{}));
+    }
+    IntegrationTestHelper::updateData(_access, origData);
+
+    auto const data = IntegrationTestHelper::getContent(_access, { { 0, 0 },{ _universeSize.x, _universeSize.y } });
+    auto changedData = data;
+    for (auto& particle : *changedData.particles) {
+        *particle.pos += QVector2D{ 0, 100 };
+    }
+    IntegrationTestHelper::updateData(_access, DataChangeDescription(data, changedData));
+
+    DataDescription newData = IntegrationTestHelper::getContent(_access, { { 0, 0 },{ _universeSize.x, _universeSize.y } });
+    ASSERT_EQ(3000, newData.particles->size());
+    auto const particleByParticleId = IntegrationTestHelper::getParticleByParticleId(newData);
+    for (auto const& particle : *changedData.particles) {
+        EXPECT_TRUE(checkCompatibility(*particle.pos, *particleByParticleId.at(particle.id).pos));
+    }
+}
+
+/**
+* Situation:
+* 	- cluster and particle in a quarter of the universe
+*   - content is duplicated to the whole universe
+* Expected result: four copies with unique ids and consistent connections are transferred
+*/
+TEST_F(DataDescriptionTransferGpuTests, testDuplicate)
+{
+    DataDescription data;
+    data.addCluster(createRectangularCluster({ 10, 10 }, QVector2D{ 100, 50 }, QVector2D{}));
+    data.addParticle(createParticle(QVector2D{ 200, 100 }, QVector2D{}));
+
+    _descHelper->duplicate(data, { _universeSize.x / 2, _universeSize.y / 2 }, _universeSize);
+    ASSERT_EQ(4, data.clusters->size());
+    ASSERT_EQ(4, data.particles->size());
+    EXPECT_EQ(400, IntegrationTestHelper::getCellByCellId(data).size());
+    EXPECT_EQ(4, IntegrationTestHelper::getClusterByClusterId(data).size());
+    checkCellConnections(data);
+
+    IntegrationTestHelper::updateData(_access, data);
+    DataDescription newData = IntegrationTestHelper::getContent(_access, { { 0, 0 },{ _universeSize.x, _universeSize.y } });
+    ASSERT_EQ(4, newData.clusters->size());
+    ASSERT_EQ(4, newData.particles->size());
+    checkCellConnections(newData);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+
+#include "Base/FlatHashMap.h"
+
+class FlatHashMapTest : public ::testing::Test
+{
+public:
+	FlatHashMapTest() = default;
+	~FlatHashMapTest() = default;
+};
+
+/**
+* Situation: random inserts, overwrites and erases on keys from a small range
+* Expected result: map always equals a std::unordered_map with the same operations
+*/
+TEST_F(FlatHashMapTest, testRandomOperations)
+{
+	FlatHashMap<uint64_t, int> map;
+	std::unordered_map<uint64_t, int> refMap;
+	uint64_t key = 1;
+	for (int i = 0; i < 100000; ++i) {
+		key = key * 6364136223846793005ULL + 1442695040888963407ULL;
+		auto const mapKey = (key >> 33) % 3000;
+		if ((key >> 20) % 3 != 0) {
+			map.insert_or_assign(mapKey, i);
+			refMap[mapKey] = i;
+		}
+		else {
+			ASSERT_EQ(refMap.erase(mapKey), map.erase(mapKey));
+		}
+	}
+
+	ASSERT_EQ(refMap.size(), map.size());
+	for (auto const& entry : refMap) {
+		EXPECT_EQ(entry.second, map.at(entry.first));
+	}
+	size_t numEntries = 0;
+	for (auto const& entry : map) {
+		EXPECT_EQ(refMap.at(entry.first), entry.second);
+		++numEntries;
+	}
+	EXPECT_EQ(refMap.size(), numEntries);
+}
+
+/**
+* Situation: set with inserted and erased keys
+* Expected result: only remaining keys are found, lookups in an empty map throw
+*/
+TEST_F(FlatHashMapTest, testSet)
+{
+	FlatHashSet<uint64_t> set;
+	for (uint64_t i = 0; i < 1000; ++i) {
+		set.insert(i);
+	}
+	for (uint64_t i = 0; i < 1000; i += 2) {
+		set.erase(i);
+	}
+
+	EXPECT_EQ(500, set.size());
+	for (uint64_t i = 0; i < 1000; ++i) {
+		EXPECT_EQ(i % 2 == 1, set.find(i) != set.end());
+	}
+
+	FlatHashMap<uint64_t, int> emptyMap;
+	EXPECT_THROW(emptyMap.at(1), std::out_of_range);
+}
@@ -1,5 +1,10 @@
+#include <QDir>
 #include <QElapsedTimer>
 
+#include "ModelBasic/PackedDescriptions.h"
+#include "ModelBasic/SerializationHelper.h"
+#include "ModelBasic/Serializer.h"
+
 #include "IntegrationGpuTestFramework.h"
 
 class GpuBenchmark
@@ -62,6 +67,78 @@ TEST_F(GpuBenchmark, testOnlyClusterMovement)
     std::cout << "Time elapsed during simulation: " << timer.elapsed() << " ms" << std::endl;
 }
 
+TEST_F(GpuBenchmark, testDataConversion)
+{
+    _parameters.radiationProb = 0;
+    _context->setSimulationParameters(_parameters);
+
+    DataDescription origData;
+    for (int i = 0; i < 250; ++i) {
+        auto cluster = createRectangularCluster({ 7, 40 },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.x)),
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.y)) },
+            QVector2D{});
+        for (int j = 0; j < 10; ++j) {
+            cluster.cells->at(j * 20).addToken(createSimpleToken());
+        }
+        origData.addCluster(cluster);
+    }
+
+    IntegrationTestHelper::updateData(_access, origData);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < 10; ++i) {
+        IntegrationTestHelper::getContent(_access, { { 0, 0 }, { _universeSize.x, _universeSize.y } });
+    }
+    std::cout << "Time elapsed during data conversion: " << timer.elapsed() << " ms" << std::endl;
+}
+
+TEST_F(GpuBenchmark, testMemoryUsageOfPackedData)
+{
+    auto serializer = _basicFacade->buildSerializer();
+    auto gpuFacade = _gpuFacade;
+    serializer->init(
+        [gpuFacade](int typeId, IntVector2D const& universeSize, SymbolTable* symbols, SimulationParameters const& parameters,
+            map<string, int> const& typeSpecificData, uint timestepAtBeginning) -> SimulationController* {
+            return gpuFacade->buildSimulationController(
+                { universeSize, symbols, parameters }, ModelGpuData(typeSpecificData), timestepAtBeginning);
+        },
+        [gpuFacade](SimulationController* controller) -> SimulationAccess* {
+            auto access = gpuFacade->buildSimulationAccess();
+            access->init(static_cast<SimulationControllerGpu*>(controller));
+            return access;
+        });
+
+    SimulationController* simController;
+    auto const filename = QDir("../../examples/simulations").filePath("evolution.sim").toStdString();
+    ASSERT_TRUE(SerializationHelper::loadFromFile<SimulationController*>(
+        filename, [&](string const& data) { return serializer->deserializeSimulation(data); }, simController));
+
+    auto access = gpuFacade->buildSimulationAccess();
+    access->init(static_cast<SimulationControllerGpu*>(simController));
+    auto const universeSize = simController->getContext()->getSpaceProperties()->getSize();
+    auto const data = IntegrationTestHelper::getContent(access, { { 0, 0 }, universeSize });
+
+    QElapsedTimer timer;
+    timer.start();
+    PackedDataDescription packedData(data);
+    auto const packingTime = timer.restart();
+    auto const unpackedData = packedData.unpack();
+    auto const unpackingTime = timer.elapsed();
+
+    std::cout << "Number of cells: " << packedData.getNumCells() << std::endl;
+    std::cout << "Memory usage of descriptions: " << PackedDataDescription::estimateMemoryUsage(data) / 1024 << " KB" << std::endl;
+    std::cout << "Memory usage of packed descriptions: " << packedData.getMemoryUsage() / 1024 << " KB" << std::endl;
+    std::cout << "Time elapsed during packing: " << packingTime << " ms, unpacking: " << unpackingTime << " ms" << std::endl;
+    EXPECT_LT(packedData.getMemoryUsage(), PackedDataDescription::estimateMemoryUsage(data));
+
+    delete access;
+    delete simController;
+    delete serializer;
+}
+
 namespace
 {
     ModelGpuData getModelGpuDataWithOneBlock()
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "Base/LockFreeHashMap.h"
+#include "Base/Parallel.h"
+
+class LockFreeHashMapTest : public ::testing::Test
+{
+public:
+	LockFreeHashMapTest() = default;
+	~LockFreeHashMapTest() = default;
+
+protected:
+	struct IntHash
+	{
+		int operator()(int value) const { return (value * 2654435761u) & 0x7fffffff; }
+	};
+	using Map = LockFreeHashMap<int, int, IntHash>;
+	using Set = LockFreeHashSet<int, IntHash>;
+};
+
+/**
+* Situation: many tasks concurrently insert and overwrite keys from overlapping ranges
+* Expected result: each key is present with the value of one of its writers and absent keys are not found
+*/
+TEST_F(LockFreeHashMapTest, testParallelInserts)
+{
+	int const numKeys = 20000;
+	std::vector<Map::Entry> entries(2 * numKeys);
+	unsigned int generation;
+	Map map;
+	map.init(entries.size(), entries.data(), &generation);
+	map.clear();
+
+	executeInParallel(4 * numKeys, [&](int index) {
+		auto const key = index % numKeys;
+		map.insertOrAssign(key, key * 4 + index / numKeys);
+	});
+
+	for (int key = 0; key < numKeys; ++key) {
+		ASSERT_TRUE(map.contains(key));
+		EXPECT_EQ(key, map.at(key) / 4);
+	}
+	EXPECT_FALSE(map.contains(numKeys));
+	EXPECT_FALSE(map.contains(-1));
+}
+
+/**
+* Situation: map is reset after inserting keys and other keys are inserted afterwards
+* Expected result: only keys of the new generation are present
+*/
+TEST_F(LockFreeHashMapTest, testReset)
+{
+	std::vector<Map::Entry> entries(100);
+	unsigned int generation;
+	Map map;
+	map.init(entries.size(), entries.data(), &generation);
+	map.clear();
+
+	for (int key = 0; key < 80; ++key) {
+		EXPECT_FALSE(map.insertOrAssign(key, key));
+	}
+	EXPECT_TRUE(map.insertOrAssign(5, 6));
+	EXPECT_EQ(6, map.at(5));
+
+	map.reset();
+	for (int key = 50; key < 130; ++key) {
+		EXPECT_FALSE(map.insertOrAssign(key, -key));
+	}
+	for (int key = 0; key < 50; ++key) {
+		EXPECT_FALSE(map.contains(key));
+	}
+	for (int key = 50; key < 130; ++key) {
+		EXPECT_EQ(-key, map.at(key));
+	}
+}
+
+/**
+* Situation: many tasks concurrently insert the same keys into a set
+* Expected result: each key is reported as new exactly once
+*/
+TEST_F(LockFreeHashMapTest, testParallelSetInserts)
+{
+	int const numKeys = 10000;
+	std::vector<Set::Entry> entries(2 * numKeys);
+	unsigned int generation;
+	Set set;
+	set.init(entries.size(), entries.data(), &generation);
+	set.clear();
+
+	std::vector<std::atomic<int>> numNewInserts(numKeys);
+	executeInParallel(8 * numKeys, [&](int index) {
+		auto const key = index % numKeys;
+		if (!set.insert(key)) {
+			++numNewInserts[key];
+		}
+	});
+
+	for (int key = 0; key < numKeys; ++key) {
+		EXPECT_TRUE(set.contains(key));
+		EXPECT_EQ(1, numNewInserts[key].load());
+	}
+}
@@ -48,3 +48,20 @@ TEST_F(NumberGeneratorTest, testTags)
 	EXPECT_EQ(2, tag & 0xffffffffffff);
 }
 
+
+TEST_F(NumberGeneratorTest, testRandomReals)
+{
+	//random numbers are taken cyclically from an array of given size
+	_numberGen->init(123, 0);
+	vector<double> expectedValues;
+	for (int i = 0; i < 123; ++i) {
+		expectedValues.emplace_back(_numberGen->getRandomReal());
+	}
+
+	vector<float> values(500);
+	_numberGen->getRandomReals(values.data(), 200);
+	_numberGen->getRandomReals(values.data() + 200, 300);
+	for (int i = 0; i < 500; ++i) {
+		EXPECT_EQ(static_cast<float>(expectedValues[i % 123]), values[i]);
+	}
+}
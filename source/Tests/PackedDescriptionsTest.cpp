@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "ModelBasic/PackedDescriptions.h"
+
+class PackedDescriptionsTest : public ::testing::Test
+{
+public:
+	PackedDescriptionsTest() = default;
+	~PackedDescriptionsTest() = default;
+
+protected:
+	ClusterDescription createCluster(uint64_t id, int numCells) const
+	{
+		ClusterDescription result;
+		result.setId(id).setPos({ static_cast<float>(id), 1 }).setVel({ 0.5f, 0 }).setAngle(30).setAngularVel(0.1)
+			.setMetadata(ClusterMetadata().setName("cluster"));
+		for (int i = 0; i < numCells; ++i) {
+			uint64_t cellId = id * 1000 + i;
+			auto cell = CellDescription().setId(cellId).setPos({ static_cast<float>(id), static_cast<float>(i) }).setEnergy(100 + i)
+				.setMaxConnections(2).setFlagTokenBlocked(i % 2 == 0).setTokenBranchNumber(i % 4)
+				.setMetadata(CellMetadata().setColor(3).setName("cell").setSourceCode("mov [1], 3"))
+				.setCellFeature(CellFeatureDescription().setType(Enums::CellFunction::SCANNER).setConstData(QByteArray(10, 'a')));
+			if (i > 0) {
+				cell.addConnection(cellId - 1);
+			}
+			if (i < numCells - 1) {
+				cell.addConnection(cellId + 1);
+			}
+			if (i == 0) {
+				cell.addToken(TokenDescription().setEnergy(30).setData(QByteArray(256, 'b')));
+			}
+			result.addCell(cell);
+		}
+		return result;
+	}
+};
+
+TEST_F(PackedDescriptionsTest, testPackAndUnpack)
+{
+	DataDescription data;
+	for (uint64_t id = 1; id <= 10; ++id) {
+		data.addCluster(createCluster(id, 20));
+	}
+	data.addCluster(ClusterDescription().setId(11));
+	for (uint64_t id = 1; id <= 10; ++id) {
+		data.addParticle(ParticleDescription().setId(500 + id).setPos({ 1, 2 }).setVel({ 0, 1 }).setEnergy(5));
+	}
+
+	auto& cell = data.clusters->at(0).cells->at(5);
+	for (uint64_t connection = 100; connection < 108; ++connection) {
+		cell.addConnection(connection);
+	}
+	cell.tokenBlocked = boost::none;
+	cell.metadata = boost::none;
+
+	PackedDataDescription packedData(data);
+	ASSERT_EQ(11, packedData.getNumClusters());
+	ASSERT_EQ(200, packedData.getNumCells());
+	ASSERT_EQ(10, packedData.getNumParticles());
+
+	auto unpackedData = packedData.unpack();
+	ASSERT_EQ(data.clusters->size(), unpackedData.clusters->size());
+	for (int i = 0; i < data.clusters->size(); ++i) {
+		EXPECT_EQ(data.clusters->at(i).getHash(), unpackedData.clusters->at(i).getHash());
+	}
+	ASSERT_EQ(data.particles->size(), unpackedData.particles->size());
+	for (int i = 0; i < data.particles->size(); ++i) {
+		EXPECT_EQ(data.particles->at(i).getHash(), unpackedData.particles->at(i).getHash());
+	}
+
+	auto const& unpackedCell = unpackedData.clusters->at(0).cells->at(5);
+	EXPECT_EQ(10, unpackedCell.connectingCells->size());
+	EXPECT_EQ(107, unpackedCell.connectingCells->back());
+	EXPECT_FALSE(unpackedCell.tokenBlocked);
+	EXPECT_FALSE(unpackedCell.metadata);
+	EXPECT_FALSE(unpackedData.clusters->at(10).cells);
+
+	EXPECT_LT(packedData.getMemoryUsage(), PackedDataDescription::estimateMemoryUsage(data));
+}
+
+TEST_F(PackedDescriptionsTest, testPackEmptyData)
+{
+	PackedDataDescription packedData{ DataDescription() };
+	EXPECT_TRUE(packedData.isEmpty());
+
+	auto unpackedData = packedData.unpack();
+	EXPECT_FALSE(unpackedData.clusters);
+	EXPECT_FALSE(unpackedData.particles);
+}
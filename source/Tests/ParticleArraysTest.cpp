@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+#include "ModelBasic/ParticleArrays.h"
+
+class ParticleArraysTest : public ::testing::Test
+{
+public:
+	ParticleArraysTest() = default;
+	~ParticleArraysTest() = default;
+
+protected:
+	vector<ParticleDescription> createParticles() const
+	{
+		vector<ParticleDescription> result;
+		for (int i = 0; i < 100; ++i) {
+			auto const vel = QVector2D{ static_cast<float>(i % 7) - 3.0f, static_cast<float>(i % 5) * 50.0f - 100.0f };
+			result.emplace_back(ParticleDescription().setId(i + 1).setPos({ static_cast<float>(i), 0.5f }).setVel(vel)
+				.setEnergy(i).setMetadata(ParticleMetadata()));
+		}
+		return result;
+	}
+
+	TorusMetric _metric{ 100, 50 };
+};
+
+/**
+* Situation: particles with velocities of up to twice the universe size move across the borders
+* Expected result: positions equal the corrected positions from TorusMetric
+*/
+TEST_F(ParticleArraysTest, testMove)
+{
+	auto particles = createParticles();
+	ParticleArrays particleArrays(particles);
+	particleArrays.move(_metric);
+
+	auto const movedParticles = particleArrays.toDescriptions();
+	ASSERT_EQ(particles.size(), movedParticles.size());
+	for (int i = 0; i < particles.size(); ++i) {
+		auto expectedPos = *particles[i].pos + *particles[i].vel;
+		_metric.correctPosition(expectedPos);
+		EXPECT_EQ(particles[i].id, movedParticles[i].id);
+		EXPECT_FLOAT_EQ(expectedPos.x(), movedParticles[i].pos->x());
+		EXPECT_FLOAT_EQ(expectedPos.y(), movedParticles[i].pos->y());
+	}
+}
+
+/**
+* Situation: every second particle is dead, all others pass the random test
+* Expected result: alive particles with enough inner energy are candidates and remain after removing the dead ones
+*/
+TEST_F(ParticleArraysTest, testTransformationCandidates)
+{
+	auto numberGen = ServiceLocator::getInstance().getService<GlobalFactory>()->buildRandomNumberGenerator();
+	numberGen->init(123, 0);
+
+	ParticleArrays particleArrays(createParticles());
+	for (int i = 0; i < particleArrays.getNumParticles(); i += 2) {
+		particleArrays.alive[i] = 0;
+	}
+
+	vector<int> candidates;
+	particleArrays.getTransformationCandidates(1.1f, 50.0f, numberGen, candidates);
+	for (int i = 0; i < particleArrays.getNumParticles(); ++i) {
+		auto const innerEnergy = particleArrays.energies[i]
+			- 0.5f * (particleArrays.velX[i] * particleArrays.velX[i] + particleArrays.velY[i] * particleArrays.velY[i]);
+		bool const expectedCandidate = 1 == particleArrays.alive[i] && innerEnergy >= 50.0f;
+		EXPECT_EQ(expectedCandidate, std::find(candidates.begin(), candidates.end(), i) != candidates.end());
+	}
+
+	particleArrays.removeDeadParticles();
+	ASSERT_EQ(50, particleArrays.getNumParticles());
+	for (int i = 0; i < 50; ++i) {
+		EXPECT_EQ(2 * i + 2, particleArrays.ids[i]);
+	}
+	delete numberGen;
+}
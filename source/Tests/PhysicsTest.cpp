@@ -129,3 +129,29 @@ TEST_F(PhysicsTest, testClockwiseAngleFromFirstToSecondVector)
     }
 }
 
+
+TEST_F(PhysicsTest, testBatchCalculations)
+{
+	int const numMasses = 1003;
+	vector<QVector2D> relPositions;
+	vector<double> x, y, velX, velY;
+	Physics::Velocities velocities{ QVector2D(0.3f, -0.2f), 2.0 };
+	for (int i = 0; i < numMasses; ++i) {
+		QVector2D relPos(_numberGen->getRandomReal(-50.0, 50.0), _numberGen->getRandomReal(-50.0, 50.0));
+		auto vel = Physics::tangentialVelocity(relPos, velocities);
+		relPositions.push_back(relPos);
+		x.push_back(relPos.x() + 100.0);
+		y.push_back(relPos.y() + 200.0);
+		velX.push_back(vel.x());
+		velY.push_back(vel.y());
+	}
+	auto center = Physics::centerOfMass(x.data(), y.data(), numMasses);
+	auto relCenter = center - QVector2D(100.0, 200.0);
+	for (auto& relPos : relPositions) {
+		relPos -= relCenter;
+	}
+
+	ASSERT_PRED2(predEqual_relative, Physics::angularMass(relPositions), Physics::angularMass(x.data(), y.data(), numMasses, center));
+	ASSERT_PRED2(predEqual_relative, Physics::angularMomentum(velocities, relPositions)
+		, Physics::angularMomentum(x.data(), y.data(), velX.data(), velY.data(), numMasses, center, velocities.linear));
+}
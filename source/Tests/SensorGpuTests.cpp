@@ -176,6 +176,18 @@ TEST_F(SensorGpuTests, testSearchByAngle_success)
         Expectations().command(Enums::SensorOut::CLUSTER_FOUND).approxAngle(-135));
 }
 
+TEST_F(SensorGpuTests, testSearchByAngle_distantSingleCluster)
+{
+    runStandardTest(
+        TestParameters()
+            .command(Enums::SensorIn::SEARCH_BY_ANGLE)
+            .angle(-135)
+            .minSize(9)
+            .relPositionOfCluster({30, 30})
+            .sizeOfCluster({3, 3}),
+        Expectations().command(Enums::SensorOut::CLUSTER_FOUND).approxAngle(-135));
+}
+
 TEST_F(SensorGpuTests, testSearchByAngle_wrongAngle)
 {
     runStandardTest(
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "ModelBasic/SharedDescriptions.h"
+
+class SharedDescriptionsTest : public ::testing::Test
+{
+public:
+	SharedDescriptionsTest() = default;
+	~SharedDescriptionsTest() = default;
+
+protected:
+	DataDescription createData(int numClusters) const
+	{
+		DataDescription result;
+		for (uint64_t id = 1; id <= numClusters; ++id) {
+			result.addCluster(ClusterDescription().setId(id).setPos({ static_cast<float>(id), 0 }).setVel({ 0, 0 }).setAngle(0).setAngularVel(0)
+				.addCell(CellDescription().setId(100 + id).setPos({ static_cast<float>(id), 0 }).setEnergy(100)));
+		}
+		result.addParticle(ParticleDescription().setId(1000).setPos({ 0, 0 }).setEnergy(10));
+		return result;
+	}
+};
+
+TEST_F(SharedDescriptionsTest, testCopyOnWrite)
+{
+	SharedDataDescription data(createData(10));
+	auto copiedData = data;
+	ASSERT_EQ(&data.getCluster(3), &copiedData.getCluster(3));
+
+	copiedData.getClusterRef(3).cells->at(0).energy = 50.0;
+	copiedData.getParticleRef(0).energy = 20.0;
+
+	EXPECT_NE(&data.getCluster(3), &copiedData.getCluster(3));
+	EXPECT_EQ(&data.getCluster(4), &copiedData.getCluster(4));
+	EXPECT_EQ(100.0, *data.getCluster(3).cells->at(0).energy);
+	EXPECT_EQ(50.0, *copiedData.getCluster(3).cells->at(0).energy);
+	EXPECT_EQ(10.0, *data.getParticle(0).energy);
+	EXPECT_EQ(20.0, *copiedData.getParticle(0).energy);
+}
+
+TEST_F(SharedDescriptionsTest, testShareUnchangedClustersWithBase)
+{
+	SharedDataDescription base(createData(10));
+
+	auto changedData = createData(10);
+	changedData.clusters->at(5).pos = QVector2D{ 50, 50 };
+	changedData.clusters->pop_back();
+	SharedDataDescription data(changedData, base);
+
+	ASSERT_EQ(9, data.getNumClusters());
+	for (int index = 0; index < data.getNumClusters(); ++index) {
+		if (5 == index) {
+			EXPECT_NE(&base.getCluster(index), &data.getCluster(index));
+		}
+		else {
+			EXPECT_EQ(&base.getCluster(index), &data.getCluster(index));
+		}
+	}
+
+	auto const unsharedData = data.toDataDescription();
+	ASSERT_EQ(changedData.clusters->size(), unsharedData.clusters->size());
+	for (int index = 0; index < changedData.clusters->size(); ++index) {
+		EXPECT_EQ(changedData.clusters->at(index).getHash(), unsharedData.clusters->at(index).getHash());
+	}
+}
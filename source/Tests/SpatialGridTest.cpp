@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "ModelBasic/SpatialGrid.h"
+
+class SpatialGridTest : public ::testing::Test
+{
+public:
+	SpatialGridTest() = default;
+	~SpatialGridTest() = default;
+
+protected:
+	//query positions are chosen near the points with offsets up to maxOffset in each direction
+	void checkQueries(vector<int> const& posX, vector<int> const& posY, int bucketSize, bool dense, int maxOffset = 2) const
+	{
+		SpatialGrid grid;
+		grid.build(posX, posY, bucketSize);
+		ASSERT_EQ(static_cast<int>(posX.size()), grid.getNumPoints());
+		EXPECT_EQ(dense, grid.isDense());
+
+		uint64_t random = 1;
+		for (int i = 0; i < 1000; ++i) {
+			random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+			auto const pointIndex = (random >> 33) % posX.size();
+			int const numOffsets = 2 * maxOffset + 1;
+			IntVector2D pos{ posX[pointIndex] + static_cast<int>((random >> 20) % numOffsets) - maxOffset
+				, posY[pointIndex] + static_cast<int>((random >> 10) % numOffsets) - maxOffset };
+			int const radius = (random >> 40) % 4;
+
+			std::set<int> indices;
+			grid.forEachInRange(pos, radius, [&](int index, int x, int y) {
+				EXPECT_EQ(posX[index], x);
+				EXPECT_EQ(posY[index], y);
+				indices.insert(index);
+			});
+			std::set<int> expectedIndices;
+			for (int index = 0; index < posX.size(); ++index) {
+				if (std::abs(posX[index] - pos.x) <= radius && std::abs(posY[index] - pos.y) <= radius) {
+					expectedIndices.insert(index);
+				}
+			}
+			EXPECT_EQ(expectedIndices, indices);
+		}
+	}
+
+	void createPoints(int numPoints, int range, vector<int>& posX, vector<int>& posY) const
+	{
+		uint64_t random = 7;
+		for (int i = 0; i < numPoints; ++i) {
+			random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+			posX.emplace_back(static_cast<int>((random >> 33) % range) - range / 3);
+			posY.emplace_back(static_cast<int>((random >> 13) % range) - range / 4);
+		}
+	}
+};
+
+/**
+* Situation: many points in a small area
+* Expected result: dense grid returns exactly the points in range
+*/
+TEST_F(SpatialGridTest, testDenseQueries)
+{
+	vector<int> posX, posY;
+	createPoints(2000, 50, posX, posY);
+	checkQueries(posX, posY, 2, true);
+}
+
+/**
+* Situation: few points spread over a large area
+* Expected result: sparse grid returns exactly the points in range
+*/
+TEST_F(SpatialGridTest, testSparseQueries)
+{
+	vector<int> posX, posY;
+	createPoints(2000, 100000, posX, posY);
+	checkQueries(posX, posY, 2, false);
+}
+
+/**
+* Situation: queries around and far outside the bounding box of the points
+* Expected result: dense grid returns exactly the points in range
+*/
+TEST_F(SpatialGridTest, testDenseQueriesOutsideBoundingBox)
+{
+	vector<int> posX, posY;
+	createPoints(2000, 50, posX, posY);
+	checkQueries(posX, posY, 2, true, 100);
+
+	SpatialGrid grid;
+	grid.build(posX, posY, 2);
+	int numFound = 0;
+	for (IntVector2D const& pos : vector<IntVector2D>{ { 1000, 0 }, { 0, 1000 }, { 1000, 1000 }, { -1000, 0 }, { 0, -1000 } }) {
+		grid.forEachInRange(pos, 3, [&](int, int, int) { ++numFound; });
+	}
+	EXPECT_EQ(0, numFound);
+}
+
+/**
+* Situation: queries around and far outside the bounding box of the points
+* Expected result: sparse grid returns exactly the points in range
+*/
+TEST_F(SpatialGridTest, testSparseQueriesOutsideBoundingBox)
+{
+	vector<int> posX, posY;
+	createPoints(2000, 100000, posX, posY);
+	checkQueries(posX, posY, 2, false, 200000);
+}
@@ -711,6 +711,53 @@ TEST_F(TokenSpreadingGpuTests, testMovementAveragingCellEnergies)
     check(origData, newData);
 }
 
+/**
+* Situation: - one horizontal cluster with 3 cells and branch numbers (0, 1, 0)
+*			 - first and third cell have a token
+*            - cells have ascending energies
+*			 - simulating one time step
+*            - no radiation
+* Expected result: cell energies are averaged with half weight since middle cell is averaged by both tokens,
+*                  energy balance fulfilled
+*/
+TEST_F(TokenSpreadingGpuTests, testMovementAveragingCellEnergies_overlappingTokens)
+{
+    DataDescription origData;
+    auto cellMinEnergy = _parameters.cellMinEnergy;
+
+    auto cluster = createHorizontalCluster(3, QVector2D{}, QVector2D{}, 0);
+    auto& firstCell = cluster.cells->at(0);
+    auto& secondCell = cluster.cells->at(1);
+    auto& thirdCell = cluster.cells->at(2);
+    firstCell.tokenBranchNumber = 0;
+    firstCell.energy = cellMinEnergy * 2;
+    secondCell.tokenBranchNumber = 1;
+    secondCell.energy = cellMinEnergy * 4;
+    thirdCell.tokenBranchNumber = 0;
+    thirdCell.energy = cellMinEnergy * 6;
+    firstCell.addToken(createSimpleToken());
+    thirdCell.addToken(createSimpleToken());
+    origData.addCluster(cluster);
+
+    std::map<uint64_t, double> expectedEnergyByCellId{
+        {firstCell.id, cellMinEnergy * 2.5}, {secondCell.id, cellMinEnergy * 4}, {thirdCell.id, cellMinEnergy * 5.5}};
+
+    IntegrationTestHelper::updateData(_access, origData);
+    IntegrationTestHelper::runSimulation(1, _controller);
+
+    DataDescription newData = IntegrationTestHelper::getContent(_access, { { 0, 0 },{ _universeSize.x, _universeSize.y } });
+
+    ASSERT_EQ(1, newData.clusters->size());
+    auto const& newCluster = newData.clusters->at(0);
+
+    EXPECT_EQ(3, newCluster.cells->size());
+
+    for (auto const& newCell : *newCluster.cells) {
+        EXPECT_EQ(expectedEnergyByCellId.at(newCell.id), *newCell.energy);
+    }
+    check(origData, newData);
+}
+
 /**
 * Situation: - one rectangular cluster with 100x100 cells and random branch numbers
 *			 - each cell has random number of tokens
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <QtMath>
+
+#include "ModelBasic/TorusMetric.h"
+
+class TorusMetricTest : public ::testing::Test
+{
+public:
+	TorusMetricTest() = default;
+	~TorusMetricTest() = default;
+
+protected:
+	TorusMetric _metric{ 600, 300 };
+};
+
+/**
+* Situation: positions inside and outside of the world, integer and fractional
+* Expected result: positions are mapped into the world like with modulo arithmetic
+*/
+TEST_F(TorusMetricTest, testCorrectPosition)
+{
+	for (int x = -2000; x <= 2000; x += 7) {
+		for (int y = -1000; y <= 1000; y += 13) {
+			int intX = x, intY = y;
+			_metric.correctPosition(intX, intY);
+			EXPECT_EQ(((x % 600) + 600) % 600, intX);
+			EXPECT_EQ(((y % 300) + 300) % 300, intY);
+
+			float floatX = x + 0.25f, floatY = y - 0.75f;
+			_metric.correctPosition(floatX, floatY);
+			EXPECT_FLOAT_EQ((((qFloor(x + 0.25f) % 600) + 600) % 600) + 0.25f, floatX);
+			EXPECT_FLOAT_EQ((((qFloor(y - 0.75f) % 300) + 300) % 300) + 0.25f, floatY);
+		}
+	}
+}
+
+/**
+* Situation: displacements of different lengths
+* Expected result: displacements are mapped to the shortest one on the torus
+*/
+TEST_F(TorusMetricTest, testCorrectDisplacement)
+{
+	float x = 590.5f, y = -10.5f;
+	_metric.correctDisplacement(x, y);
+	EXPECT_FLOAT_EQ(-9.5f, x);
+	EXPECT_FLOAT_EQ(-10.5f, y);
+
+	x = -299.5f, y = 160.0f;
+	_metric.correctDisplacement(x, y);
+	EXPECT_FLOAT_EQ(-299.5f, x);
+	EXPECT_FLOAT_EQ(-140.0f, y);
+}
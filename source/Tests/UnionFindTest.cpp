@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include "Base/Parallel.h"
+#include "Base/UnionFind.h"
+
+class UnionFindTest : public ::testing::Test
+{
+public:
+	UnionFindTest() = default;
+	~UnionFindTest() = default;
+};
+
+/**
+* Situation: grid graph whose columns are separated by missing edges, edges are united in parallel
+* Expected result: one component per column segment with deterministic component indices
+*/
+TEST_F(UnionFindTest, testParallelComponents)
+{
+	int const sizeX = 300;
+	int const sizeY = 300;
+	int const segmentWidth = 7;
+	UnionFind components(sizeX * sizeY);
+	executeInParallel(sizeX * sizeY, [&](int index) {
+		int const x = index % sizeX;
+		int const y = index / sizeX;
+		if (x + 1 < sizeX && (x + 1) % segmentWidth != 0) {
+			components.unite(index, index + 1);
+		}
+		if (y + 1 < sizeY) {
+			components.unite(index + sizeX, index);
+		}
+	}, 256);
+
+	std::vector<int> componentIndices;
+	auto const numSegments = (sizeX + segmentWidth - 1) / segmentWidth;
+	ASSERT_EQ(numSegments, components.getComponentIndices(componentIndices));
+	for (int index = 0; index < sizeX * sizeY; ++index) {
+		int const x = index % sizeX;
+		EXPECT_EQ(x / segmentWidth, componentIndices[index]);
+		EXPECT_EQ(x / segmentWidth * segmentWidth, components.findRoot(index));
+	}
+}